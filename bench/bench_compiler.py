@@ -0,0 +1,207 @@
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+PHASE_PATTERN = re.compile(r'^  (.+?)\s+([\d.]+) ms$')
+
+COMPILE_PHASES = ['análise sintática', 'geração de IR', 'verificação', 'otimização', 'escrita do bitcode']
+
+def wide_block(size: int) -> str:
+    lines = ['boot', '    byte total: i32 = 0;']
+    for i in range(size):
+        lines.append(f'    total = total + {i % 97};')
+    lines.append('    log(total);')
+    lines.append('shutdown')
+    return '\n'.join(lines)
+
+def deep_nesting(size: int) -> str:
+    depth = size // 2
+    lines = ['boot', '    byte x: i32 = 1;']
+    for i in range(depth):
+        lines.append('    ' + '  ' * i + 'ping (x > 0) then')
+    lines.append('    ' + '  ' * depth + 'log(x);')
+    for i in reversed(range(depth)):
+        lines.append('    ' + '  ' * i + 'end')
+    lines.append('shutdown')
+    return '\n'.join(lines)
+
+def long_expression(size: int) -> str:
+    lines = ['boot', '    byte x: i32 = 0;', '    byte y: i32 = 1']
+    for i in range(size):
+        lines.append(f'        + x * {i % 13}')
+    lines[-1] += ';'
+    lines.append('    log(y);')
+    lines.append('shutdown')
+    return '\n'.join(lines)
+
+def many_variables(size: int) -> str:
+    lines = ['boot']
+    for i in range(size):
+        if i == 0:
+            lines.append('    byte v0: i32 = 1;')
+        else:
+            lines.append(f'    byte v{i}: i32 = v{i - 1} + {i % 7};')
+    lines.append(f'    log(v{size - 1});')
+    lines.append('shutdown')
+    return '\n'.join(lines)
+
+def big_select(size: int) -> str:
+    lines = ['boot', '    byte x: i32 = reader(i32);', '    select(x) then']
+    for i in range(size // 3):
+        lines.append(f'        when {i} then')
+        lines.append(f'            log({i * 3});')
+        lines.append('        end')
+    lines.append('        otherwise then')
+    lines.append('            log(0);')
+    lines.append('        end')
+    lines.append('    end')
+    lines.append('shutdown')
+    return '\n'.join(lines)
+
+GENERATORS = {
+    'wide': (wide_block, [1000, 4000, 16000]),
+    'deep': (deep_nesting, [200, 400, 800]),
+    'long-expr': (long_expression, [1000, 4000, 16000]),
+    'vars': (many_variables, [1000, 4000, 16000]),
+    'select': (big_select, [1000, 4000, 16000]),
+}
+
+def run_compiler(compiler: str, source_path: str, output_path: str) -> dict:
+    result = subprocess.run([compiler, source_path, '--compile', f'--output={output_path}', '--time-phases'],
+                            stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True)
+
+    if result.returncode != 0:
+        raise RuntimeError(f'{compiler} falhou com status {result.returncode}')
+
+    phases = {}
+    for line in result.stderr.splitlines():
+        match = PHASE_PATTERN.match(line)
+        if match:
+            phases[match.group(1)] = float(match.group(2))
+
+    missing = [phase for phase in COMPILE_PHASES if phase not in phases]
+    if missing:
+        raise RuntimeError(f'Fases ausentes na saída de --time-phases: {", ".join(missing)}')
+
+    return {'phases': phases}
+
+def measure(compiler: str, name: str, size: int, repeat: int, workdir: str) -> dict:
+    generator = GENERATORS[name][0]
+    source = generator(size)
+    line_count = source.count('\n') + 1
+    source_path = os.path.join(workdir, f'{name}-{size}.tf')
+    output_path = os.path.join(workdir, f'{name}-{size}.bc')
+
+    with open(source_path, 'w') as file:
+        file.write(source)
+
+    best = None
+    for _ in range(repeat):
+        run = run_compiler(compiler, source_path, output_path)
+        run['front'] = sum(run['phases'][phase] for phase in COMPILE_PHASES)
+        if best is None or run['front'] < best['front']:
+            best = run
+
+    best['lines'] = line_count
+    best['lines_per_second'] = line_count / (best['front'] / 1000.0) if best['front'] > 0 else float('inf')
+    return best
+
+def print_result(name: str, size: int, result: dict) -> None:
+    phases = result['phases']
+    columns = ' '.join(f'{phases[phase]:9.2f}' for phase in COMPILE_PHASES)
+    print(f'{name:<10} {result["lines"]:>7} {result["lines_per_second"]:>12.0f} {columns} {phases.get("impressão do IR", 0.0):9.2f}')
+
+def scaling(results: dict) -> float:
+    sizes = sorted(results)
+    small = results[sizes[0]]
+    large = results[sizes[-1]]
+    return (large['front'] / large['lines']) / (small['front'] / small['lines'])
+
+def check(baselines: dict, measured: dict, threshold: float) -> list:
+    failures = []
+
+    for name, results in measured.items():
+        baseline = baselines.get(name)
+        if baseline is None:
+            continue
+
+        for size, result in results.items():
+            expected = baseline['lines_per_second'].get(str(size))
+            if expected is not None and result['lines_per_second'] < expected * (1.0 - threshold):
+                failures.append(f'{name} ({size} linhas): {result["lines_per_second"]:.0f} linhas/s, '
+                                f'base {expected:.0f} linhas/s')
+
+        ratio = scaling(results)
+        if ratio > baseline['scaling'] * (1.0 + threshold):
+            failures.append(f'{name}: custo por linha cresce {ratio:.2f}x do menor para o maior tamanho, '
+                            f'base {baseline["scaling"]:.2f}x')
+
+    return failures
+
+def main():
+    parser = argparse.ArgumentParser(description='Benchmark de throughput do compilador TechFlow')
+    parser.add_argument('--compiler', default='bin/techflow')
+    parser.add_argument('--baselines', default=os.path.join(os.path.dirname(__file__), 'baselines.json'))
+    parser.add_argument('--threshold', type=float, default=0.35)
+    parser.add_argument('--repeat', type=int, default=5)
+    parser.add_argument('--only', action='append', choices=sorted(GENERATORS))
+    parser.add_argument('--update', action='store_true')
+    args = parser.parse_args()
+
+    if not os.path.exists(args.compiler):
+        print(f'Compilador {args.compiler} não encontrado')
+        sys.exit(1)
+
+    names = args.only or list(GENERATORS)
+    measured = {}
+
+    print(f'{"gerador":<10} {"linhas":>7} {"linhas/s":>12} {"análise":>9} {"geração":>9} {"verif.":>9} '
+          f'{"otimiz.":>9} {"escrita":>9} {"dump":>9}')
+
+    with tempfile.TemporaryDirectory(prefix='techflow-bench-') as workdir:
+        for name in names:
+            measured[name] = {}
+            for size in GENERATORS[name][1]:
+                result = measure(args.compiler, name, size, args.repeat, workdir)
+                measured[name][size] = result
+                print_result(name, size, result)
+            print(f'{"":<10} escala do custo por linha: {scaling(measured[name]):.2f}x')
+
+    if args.update:
+        baselines = {}
+        if os.path.exists(args.baselines):
+            with open(args.baselines) as file:
+                baselines = json.load(file)
+        for name, results in measured.items():
+            baselines[name] = {
+                'lines_per_second': {str(size): round(result['lines_per_second']) for size, result in results.items()},
+                'scaling': round(scaling(results), 2)
+            }
+        with open(args.baselines, 'w') as file:
+            json.dump(baselines, file, indent=2, ensure_ascii=False)
+            file.write('\n')
+        print(f'Referências gravadas em {args.baselines}')
+        return
+
+    if not os.path.exists(args.baselines):
+        print(f'Arquivo de referências {args.baselines} não encontrado; use --update para criá-lo')
+        sys.exit(1)
+
+    with open(args.baselines) as file:
+        baselines = json.load(file)
+
+    failures = check(baselines, measured, args.threshold)
+    if failures:
+        print(f'\nRegressões acima de {args.threshold:.0%}:')
+        for failure in failures:
+            print(f'  {failure}')
+        sys.exit(1)
+
+    print(f'\nNenhuma regressão acima de {args.threshold:.0%}.')
+
+if __name__ == '__main__':
+    main()
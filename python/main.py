@@ -1,5 +1,4 @@
 import sys
-from techflow.prepro import PrePro
 from techflow.parser import Parser
 from techflow.symboltable import SymbolTable
 
@@ -15,7 +14,6 @@ def main():
         print(f"Arquivo {filepath} não encontrado")
         sys.exit(1)
     
-    code = PrePro.filter(code)
     try:
         ast = Parser.run(code)
         symbol_table = SymbolTable()
@@ -1,3 +1,5 @@
+import re
+import sys
 from abc import ABC, abstractmethod
 from techflow.symboltable import SymbolTable
 
@@ -10,14 +12,67 @@ class Node(ABC):
     def Evaluate(self, symbol_table: SymbolTable):
         pass
 
+class Statement(Node):
+    @abstractmethod
+    def Steps(self, symbol_table: SymbolTable):
+        pass
+        
+    def Evaluate(self, symbol_table: SymbolTable):
+        return execute(self, symbol_table)
+
+def evaluate_expression(root: Node, symbol_table: SymbolTable):
+    values = []
+    stack = [(root, False)]
+    while stack:
+        node, visited = stack.pop()
+        if isinstance(node, BinOp):
+            if visited:
+                right = values.pop()
+                left = values.pop()
+                values.append(node.Apply(left, right))
+            else:
+                stack.append((node, True))
+                stack.append((node.children[1], False))
+                stack.append((node.children[0], False))
+        elif isinstance(node, UnOp):
+            if visited:
+                values.append(node.Apply(values.pop()))
+            else:
+                stack.append((node, True))
+                stack.append((node.children[0], False))
+        else:
+            values.append(node.Evaluate(symbol_table))
+    return values.pop()
+
+def execute(root: Statement, symbol_table: SymbolTable):
+    frames = [root.Steps(symbol_table)]
+    result = None
+    while frames:
+        try:
+            child = frames[-1].send(result)
+        except StopIteration as stop:
+            frames.pop()
+            result = stop.value
+            continue
+            
+        if isinstance(child, Statement):
+            frames.append(child.Steps(symbol_table))
+            result = None
+        else:
+            result = child.Evaluate(symbol_table)
+    return result
+
 class BinOp(Node):
     def __init__(self, op, left: Node, right: Node):
         super().__init__(op)
         self.children = [left, right]
         
     def Evaluate(self, symbol_table: SymbolTable):
-        left_val, left_type = self.children[0].Evaluate(symbol_table)
-        right_val, right_type = self.children[1].Evaluate(symbol_table)
+        return evaluate_expression(self, symbol_table)
+        
+    def Apply(self, left, right):
+        left_val, left_type = left
+        right_val, right_type = right
         
         if self.value == '+':
             if left_type == "i32" and right_type == "i32":
@@ -113,7 +168,10 @@ class UnOp(Node):
         self.children = [child]
         
     def Evaluate(self, symbol_table: SymbolTable):
-        child_val, child_type = self.children[0].Evaluate(symbol_table)
+        return evaluate_expression(self, symbol_table)
+        
+    def Apply(self, child):
+        child_val, child_type = child
         
         if self.value == '+':
             if child_type == "i32":
@@ -222,15 +280,15 @@ class Print(Node):
             print(val)
         return (val, typ)
 
-class Block(Node):
+class Block(Statement):
     def __init__(self, statements: list):
         super().__init__('block')
         self.statements = statements
         
-    def Evaluate(self, symbol_table: SymbolTable):
+    def Steps(self, symbol_table: SymbolTable):
         result = (None, None)
         for stmt in self.statements:
-            result = stmt.Evaluate(symbol_table)
+            result = yield stmt
         return result
 
 class NoOp(Node):
@@ -240,48 +298,48 @@ class NoOp(Node):
     def Evaluate(self, symbol_table: SymbolTable):
         return (None, None)
 
-class If(Node):
+class If(Statement):
     def __init__(self, condition: Node, then_branch: Node, else_branch: Node = None):
         super().__init__('ping')
         self.condition = condition
         self.then_branch = then_branch
         self.else_branch = else_branch
         
-    def Evaluate(self, symbol_table: SymbolTable):
+    def Steps(self, symbol_table: SymbolTable):
         cond_val, cond_type = self.condition.Evaluate(symbol_table)
         if cond_type != "bool":
             raise ValueError("Condição do ping deve ser booleana")
         if cond_val:
-            return self.then_branch.Evaluate(symbol_table)
+            return (yield self.then_branch)
         elif self.else_branch is not None:
-            return self.else_branch.Evaluate(symbol_table)
+            return (yield self.else_branch)
         return (None, None)
 
-class While(Node):
+class While(Statement):
     def __init__(self, condition: Node, body: Node):
         super().__init__('stream')
         self.condition = condition
         self.body = body
         
-    def Evaluate(self, symbol_table: SymbolTable):
+    def Steps(self, symbol_table: SymbolTable):
         while True:
             cond_val, cond_type = self.condition.Evaluate(symbol_table)
             if cond_type != "bool":
                 raise ValueError("Condição do stream deve ser booleana")
             if not cond_val:
                 break
-            self.body.Evaluate(symbol_table)
+            yield self.body
         return (None, None)
 
-class Repeat(Node):
+class Repeat(Statement):
     def __init__(self, body: Node, condition: Node):
         super().__init__('repeat')
         self.body = body
         self.condition = condition
         
-    def Evaluate(self, symbol_table: SymbolTable):
+    def Steps(self, symbol_table: SymbolTable):
         while True:
-            self.body.Evaluate(symbol_table)
+            yield self.body
             cond_val, cond_type = self.condition.Evaluate(symbol_table)
             if cond_type != "bool":
                 raise ValueError("Condição do repeat-until deve ser booleana")
@@ -289,14 +347,14 @@ class Repeat(Node):
                 break
         return (None, None)
 
-class SwitchCase(Node):
+class SwitchCase(Statement):
     def __init__(self, condition: Node, cases: list, default_case: Node = None):
         super().__init__('select')
         self.condition = condition
         self.cases = cases
         self.default_case = default_case
         
-    def Evaluate(self, symbol_table: SymbolTable):
+    def Steps(self, symbol_table: SymbolTable):
         cond_val, cond_type = self.condition.Evaluate(symbol_table)
         
         for case_value, case_block in self.cases:
@@ -306,27 +364,69 @@ class SwitchCase(Node):
                 raise ValueError(f"Tipo incompatível no select: {cond_type} vs {case_type}")
                 
             if cond_val == case_val:
-                return case_block.Evaluate(symbol_table)
+                return (yield case_block)
                 
         if self.default_case is not None:
-            return self.default_case.Evaluate(symbol_table)
+            return (yield self.default_case)
             
         return (None, None)
 
+class InputReader:
+    NUMBER = re.compile(r'[-+]?[0-9]+')
+
+    def __init__(self, stream):
+        self.stream = stream
+        self.buffer = ''
+
+    def fill(self) -> bool:
+        if not self.buffer:
+            self.buffer = self.stream.readline()
+        return self.buffer != ''
+
+    def read_line(self) -> str:
+        if not self.fill():
+            return ''
+        line, _, self.buffer = self.buffer.partition('\n')
+        return line[:-1] if line.endswith('\r') else line
+
+    def read_i32(self) -> int:
+        while self.fill():
+            self.buffer = self.buffer.lstrip(' \t\r\n')
+            if self.buffer:
+                break
+        if not self.buffer:
+            return 0
+
+        match = self.NUMBER.match(self.buffer)
+        if match is None:
+            raise ValueError("Valor inválido para reader")
+        value = int(match.group())
+        if value < -2**31 or value >= 2**31:
+            raise ValueError("Valor fora do intervalo de i32 em reader")
+
+        rest = self.buffer[match.end():].lstrip(' \t\r')
+        self.buffer = rest[1:] if rest.startswith('\n') else rest
+        return value
+
+stdin_reader = None
+
 class Reader(Node):
-    def __init__(self):
+    def __init__(self, data_type: str = "i32"):
         super().__init__('reader')
+        self.data_type = data_type
         
     def Evaluate(self, symbol_table: SymbolTable):
-        try:
-            return (int(input()), "i32")
-        except:
-            raise ValueError("Valor inválido para reader")
+        global stdin_reader
+        if stdin_reader is None:
+            stdin_reader = InputReader(sys.stdin)
+        if self.data_type == "str":
+            return (stdin_reader.read_line(), "str")
+        return (stdin_reader.read_i32(), "i32")
 
-class Program(Node):
+class Program(Statement):
     def __init__(self, body: Node):
         super().__init__('program')
         self.body = body
         
-    def Evaluate(self, symbol_table: SymbolTable):
-        return self.body.Evaluate(symbol_table)
\ No newline at end of file
+    def Steps(self, symbol_table: SymbolTable):
+        return (yield self.body)
\ No newline at end of file
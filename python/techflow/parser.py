@@ -176,6 +176,11 @@ class Parser:
             tokenizer.selectNext()
             if tokenizer.next.type == '(':
                 tokenizer.selectNext()
+                if tokenizer.next.type == 'TYPE':
+                    if tokenizer.next.value not in ['i32', 'str']:
+                        raise ValueError("reader suporta apenas i32 e str")
+                    reader_node = Reader(tokenizer.next.value)
+                    tokenizer.selectNext()
                 if tokenizer.next.type != ')':
                     raise ValueError("Esperado ')' após reader")
                 tokenizer.selectNext()
@@ -270,6 +275,11 @@ class Parser:
             tokenizer.selectNext()
             if tokenizer.next.type == '(':
                 tokenizer.selectNext()
+                if tokenizer.next.type == 'TYPE':
+                    if tokenizer.next.value not in ['i32', 'str']:
+                        raise ValueError("reader suporta apenas i32 e str")
+                    reader_node = Reader(tokenizer.next.value)
+                    tokenizer.selectNext()
                 if tokenizer.next.type != ')':
                     raise ValueError("Esperado ')' após reader/scanf")
                 tokenizer.selectNext()
@@ -1,8 +0,0 @@
-import re
-
-class PrePro:
-    @staticmethod
-    def filter(code: str) -> str:
-        code = re.sub(r'/\*.*?\*/', '', code, flags=re.DOTALL)
-        code = re.sub(r'//.*', '', code)
-        return code
\ No newline at end of file
@@ -0,0 +1,58 @@
+import os
+import subprocess
+import sys
+import tempfile
+import unittest
+
+ROOT = os.path.join(os.path.dirname(__file__), '..', '..')
+PYTHON_MAIN = os.path.join(ROOT, 'python', 'main.py')
+C_COMPILER = os.environ.get('TECHFLOW_BIN', os.path.join(ROOT, 'bin', 'techflow'))
+
+PROGRAM = '''boot
+    byte a: i32 = reader();
+    byte b: i32 = reader();
+    byte c: i32 = reader();
+    byte s: str = reader(str);
+    byte t: str = reader(str);
+    log(a * 100 + b * 10 + c);
+    log(s);
+    log(t);
+    log(reader());
+shutdown
+'''
+
+INPUT = '1 2\n  3\t\nhello world\r\nlast\n'
+
+class ReaderTest(unittest.TestCase):
+    def setUp(self) -> None:
+        source = tempfile.NamedTemporaryFile('w', suffix='.tf', delete=False)
+        source.write(PROGRAM)
+        source.close()
+        self.source = source.name
+
+    def tearDown(self) -> None:
+        os.unlink(self.source)
+
+    def run_python(self) -> list:
+        result = subprocess.run([sys.executable, PYTHON_MAIN, self.source], input=INPUT,
+                                capture_output=True, text=True, timeout=30)
+        self.assertEqual(result.returncode, 0, result.stdout + result.stderr)
+        return result.stdout.splitlines()
+
+    def run_c(self) -> list:
+        result = subprocess.run([C_COMPILER, self.source, '--interpret'], input=INPUT,
+                                capture_output=True, text=True, timeout=30)
+        self.assertEqual(result.returncode, 0, result.stdout + result.stderr)
+        lines = result.stdout.splitlines()
+        start = lines.index('Executando programa...') + 1
+        return lines[start:lines.index('Execução concluída.')]
+
+    def test_tokenizes_numbers_across_lines(self) -> None:
+        self.assertEqual(self.run_python(), ['123', 'hello world', 'last', '0'])
+
+    @unittest.skipUnless(os.access(C_COMPILER, os.X_OK), 'bin/techflow não compilado')
+    def test_matches_c_interpreter(self) -> None:
+        self.assertEqual(self.run_python(), self.run_c())
+
+if __name__ == '__main__':
+    unittest.main()
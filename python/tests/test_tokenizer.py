@@ -0,0 +1,37 @@
+import os
+import sys
+import time
+import unittest
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..'))
+
+from techflow.tokenizer import Tokenizer
+
+class TokenizerTest(unittest.TestCase):
+    def tokens(self, source: str) -> list:
+        tokenizer = Tokenizer(source)
+        result = []
+        while tokenizer.next.type != 'EOF':
+            result.append(tokenizer.next.type)
+            tokenizer.selectNext()
+        return result
+
+    def assertRejectedQuickly(self, source: str) -> None:
+        start = time.monotonic()
+        with self.assertRaises(ValueError):
+            self.tokens(source)
+        self.assertLess(time.monotonic() - start, 1.0)
+
+    def test_skips_whitespace_and_comments(self) -> None:
+        source = 'boot  // linha\n  /* bloco\n */ log(1);\nshutdown'
+        self.assertEqual(self.tokens(source), ['BOOT', 'LOG', '(', 'NUMBER', ')', ';', 'SHUTDOWN'])
+
+    def test_long_whitespace_before_invalid_character(self) -> None:
+        for invalid in ['@', '&', '|']:
+            self.assertRejectedQuickly('boot' + ' ' * 4096 + invalid)
+
+    def test_long_whitespace_before_unterminated_comment(self) -> None:
+        self.assertRejectedQuickly('boot' + ' \n' * 4096 + '/* sem fim')
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,391 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include "checkpoint.h"
+
+typedef struct {
+    const Node* node;
+    const Node* parent;
+    uint32_t index;
+} CheckpointEntry;
+
+struct CheckpointMap {
+    CheckpointEntry* entries;
+    int entry_count;
+    int capacity;
+    int* buckets;
+    int bucket_count;
+    uint64_t fingerprint;
+    bool uses_tasks;
+};
+
+static void mix_bytes(CheckpointMap* map, const void* data, size_t size) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    
+    for (size_t i = 0; i < size; i++) {
+        map->fingerprint ^= bytes[i];
+        map->fingerprint *= 0x100000001B3ull;
+    }
+}
+
+static void mix_int(CheckpointMap* map, int64_t value) {
+    mix_bytes(map, &value, sizeof(value));
+}
+
+static void mix_string(CheckpointMap* map, const char* str) {
+    if (str == NULL) {
+        mix_int(map, -1);
+        return;
+    }
+    mix_bytes(map, str, strlen(str) + 1);
+}
+
+static void add_entry(CheckpointMap* map, const Node* node, const Node* parent, uint32_t index) {
+    if (map->entry_count == map->capacity) {
+        map->capacity = map->capacity == 0 ? 64 : map->capacity * 2;
+        map->entries = (CheckpointEntry*)realloc(map->entries, map->capacity * sizeof(CheckpointEntry));
+    }
+    
+    CheckpointEntry* entry = &map->entries[map->entry_count++];
+    entry->node = node;
+    entry->parent = parent;
+    entry->index = index;
+}
+
+static void visit(CheckpointMap* map, const Node* node, const Node* parent, uint32_t index) {
+    if (node == NULL) {
+        mix_int(map, -1);
+        return;
+    }
+    
+    mix_int(map, node->type);
+    add_entry(map, node, parent, index);
+    
+    switch (node->type) {
+        case NODE_PROGRAM:
+            visit(map, node->data.program.body, NULL, 0);
+            break;
+        case NODE_BLOCK:
+            mix_int(map, node->data.block.stmt_count);
+            for (int i = 0; i < node->data.block.stmt_count; i++) {
+                visit(map, node->data.block.statements[i], node, (uint32_t)i);
+            }
+            break;
+        case NODE_VAR_DECL:
+            mix_string(map, node->data.var_decl.name);
+            mix_string(map, node->data.var_decl.data_type);
+            visit(map, node->data.var_decl.init_expr, node, 0);
+            break;
+        case NODE_ASSIGN:
+            mix_string(map, node->data.assign.name);
+            visit(map, node->data.assign.value, node, 0);
+            break;
+        case NODE_IF:
+            visit(map, node->data.if_stmt.condition, node, 2);
+            visit(map, node->data.if_stmt.then_branch, node, 0);
+            visit(map, node->data.if_stmt.else_branch, node, 1);
+            break;
+        case NODE_WHILE:
+            visit(map, node->data.while_stmt.condition, node, 1);
+            visit(map, node->data.while_stmt.body, node, 0);
+            break;
+        case NODE_REPEAT:
+            visit(map, node->data.repeat_stmt.body, node, 0);
+            visit(map, node->data.repeat_stmt.condition, node, 1);
+            break;
+        case NODE_SWITCH:
+            visit(map, node->data.switch_stmt.condition, node, UINT32_MAX);
+            mix_int(map, node->data.switch_stmt.case_count);
+            for (int i = 0; i < node->data.switch_stmt.case_count; i++) {
+                const Node* case_node = node->data.switch_stmt.cases[i];
+                mix_int(map, case_node->type);
+                visit(map, case_node->data.case_stmt.value, node, UINT32_MAX);
+                visit(map, case_node->data.case_stmt.body, node, (uint32_t)i);
+            }
+            visit(map, node->data.switch_stmt.default_case, node, (uint32_t)node->data.switch_stmt.case_count);
+            break;
+        case NODE_PRINT:
+            visit(map, node->data.print_stmt.expr, node, 0);
+            break;
+        case NODE_BINARY_OP:
+            mix_string(map, node->data.binary_op.operator);
+            visit(map, node->data.binary_op.left, node, 0);
+            visit(map, node->data.binary_op.right, node, 1);
+            break;
+        case NODE_UNARY_OP:
+            mix_string(map, node->data.unary_op.operator);
+            visit(map, node->data.unary_op.operand, node, 0);
+            break;
+        case NODE_INT_VAL:
+            mix_int(map, node->data.int_value);
+            break;
+        case NODE_BOOL_VAL:
+            mix_int(map, node->data.bool_value);
+            break;
+        case NODE_STRING_VAL:
+        case NODE_IDENTIFIER:
+            mix_string(map, node->data.str_value);
+            break;
+        case NODE_READ:
+            mix_string(map, node->data.read_expr.data_type);
+            break;
+        case NODE_PARALLEL_FOR:
+            mix_string(map, node->data.parallel_for.var_name);
+            mix_int(map, node->data.parallel_for.reduce_count);
+            for (int i = 0; i < node->data.parallel_for.reduce_count; i++) {
+                mix_string(map, node->data.parallel_for.reduce_ops[i]);
+                mix_string(map, node->data.parallel_for.reduce_vars[i]);
+            }
+            visit(map, node->data.parallel_for.start, node, 1);
+            visit(map, node->data.parallel_for.end, node, 2);
+            visit(map, node->data.parallel_for.body, node, 0);
+            break;
+        case NODE_SPAWN:
+        case NODE_CHANNEL_DECL:
+        case NODE_SEND:
+        case NODE_RECEIVE:
+        case NODE_CLOSE:
+        case NODE_RECEIVE_LOOP:
+            map->uses_tasks = true;
+            break;
+        default:
+            break;
+    }
+}
+
+static size_t hash_node(const Node* node, int bucket_count) {
+    return (size_t)(((uintptr_t)node >> 4) * 0x9E3779B97F4A7C15ull) & (size_t)(bucket_count - 1);
+}
+
+CheckpointMap* create_checkpoint_map(Node* root, char* error, size_t error_size) {
+    CheckpointMap* map = (CheckpointMap*)calloc(1, sizeof(CheckpointMap));
+    map->fingerprint = 0xCBF29CE484222325ull;
+    visit(map, root, NULL, 0);
+    
+    if (map->uses_tasks) {
+        snprintf(error, error_size, "Erro: checkpoints não são suportados em programas com spawn ou canais");
+        free_checkpoint_map(map);
+        return NULL;
+    }
+    
+    map->bucket_count = 16;
+    while (map->bucket_count < map->entry_count * 2) {
+        map->bucket_count *= 2;
+    }
+    
+    map->buckets = (int*)malloc(map->bucket_count * sizeof(int));
+    for (int i = 0; i < map->bucket_count; i++) {
+        map->buckets[i] = -1;
+    }
+    
+    for (int i = 0; i < map->entry_count; i++) {
+        size_t bucket = hash_node(map->entries[i].node, map->bucket_count);
+        while (map->buckets[bucket] != -1) {
+            bucket = (bucket + 1) & (size_t)(map->bucket_count - 1);
+        }
+        map->buckets[bucket] = i;
+    }
+    
+    return map;
+}
+
+void free_checkpoint_map(CheckpointMap* map) {
+    if (map == NULL) return;
+    
+    free(map->entries);
+    free(map->buckets);
+    free(map);
+}
+
+uint64_t checkpoint_fingerprint(const CheckpointMap* map) {
+    return map->fingerprint;
+}
+
+static const CheckpointEntry* find_entry(const CheckpointMap* map, const Node* node) {
+    size_t bucket = hash_node(node, map->bucket_count);
+    
+    while (map->buckets[bucket] != -1) {
+        const CheckpointEntry* entry = &map->entries[map->buckets[bucket]];
+        if (entry->node == node) return entry;
+        bucket = (bucket + 1) & (size_t)(map->bucket_count - 1);
+    }
+    
+    return NULL;
+}
+
+uint32_t* checkpoint_path(const CheckpointMap* map, const Node* node, uint32_t extra, uint32_t* length) {
+    uint32_t depth = 0;
+    const CheckpointEntry* entry = find_entry(map, node);
+    
+    for (const CheckpointEntry* e = entry; e != NULL && e->parent != NULL && e->parent->type != NODE_PROGRAM;
+         e = find_entry(map, e->parent)) {
+        depth++;
+    }
+    
+    uint32_t* path = (uint32_t*)malloc((depth + 1) * sizeof(uint32_t));
+    path[depth] = extra;
+    
+    uint32_t position = depth;
+    for (const CheckpointEntry* e = entry; position > 0; e = find_entry(map, e->parent)) {
+        path[--position] = e->index;
+    }
+    
+    *length = depth + 1;
+    return path;
+}
+
+static bool write_value(FILE* file, const void* data, size_t size) {
+    return size == 0 || fwrite(data, size, 1, file) == 1;
+}
+
+static bool write_u32(FILE* file, uint32_t value) {
+    return write_value(file, &value, sizeof(value));
+}
+
+int write_checkpoint(const Checkpoint* checkpoint, const char* path, char* error, size_t error_size) {
+    size_t path_size = strlen(path) + 5;
+    char* temp_path = (char*)malloc(path_size);
+    snprintf(temp_path, path_size, "%s.tmp", path);
+    
+    FILE* file = fopen(temp_path, "wb");
+    if (file == NULL) {
+        snprintf(error, error_size, "Erro: não foi possível gravar o checkpoint '%s'", path);
+        free(temp_path);
+        return 1;
+    }
+    
+    bool ok = write_value(file, CHECKPOINT_MAGIC, 4) &&
+              write_u32(file, CHECKPOINT_VERSION) &&
+              write_value(file, &checkpoint->fingerprint, sizeof(uint64_t)) &&
+              write_value(file, &checkpoint->input_offset, sizeof(uint64_t)) &&
+              write_u32(file, checkpoint->path_length) &&
+              write_value(file, checkpoint->path, checkpoint->path_length * sizeof(uint32_t)) &&
+              write_u32(file, checkpoint->variable_count);
+    
+    for (uint32_t i = 0; ok && i < checkpoint->variable_count; i++) {
+        const CheckpointVariable* variable = &checkpoint->variables[i];
+        uint32_t name_length = (uint32_t)strlen(variable->name);
+        
+        ok = write_u32(file, name_length) &&
+             write_value(file, variable->name, name_length) &&
+             write_u32(file, variable->type) &&
+             write_u32(file, variable->depth);
+        
+        if (ok && variable->type == CHECKPOINT_STR) {
+            ok = write_u32(file, variable->str_length) &&
+                 write_value(file, variable->str_value, variable->str_length);
+        } else if (ok) {
+            ok = write_value(file, &variable->int_value, sizeof(int32_t));
+        }
+    }
+    
+    ok = ok && fflush(file) == 0 && fsync(fileno(file)) == 0;
+    ok = fclose(file) == 0 && ok;
+    ok = ok && rename(temp_path, path) == 0;
+    
+    if (!ok) {
+        remove(temp_path);
+        snprintf(error, error_size, "Erro: não foi possível gravar o checkpoint '%s'", path);
+    }
+    
+    free(temp_path);
+    return ok ? 0 : 1;
+}
+
+static bool read_value(FILE* file, void* data, size_t size) {
+    return size == 0 || fread(data, size, 1, file) == 1;
+}
+
+static bool read_u32(FILE* file, uint32_t* value) {
+    return read_value(file, value, sizeof(*value));
+}
+
+static char* read_text(FILE* file, uint32_t length) {
+    char* text = (char*)malloc((size_t)length + 1);
+    
+    if (text == NULL || !read_value(file, text, length)) {
+        free(text);
+        return NULL;
+    }
+    
+    text[length] = '\0';
+    return text;
+}
+
+int load_checkpoint(const char* path, Checkpoint* checkpoint, char* error, size_t error_size) {
+    memset(checkpoint, 0, sizeof(*checkpoint));
+    
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        snprintf(error, error_size, "Erro: não foi possível abrir o checkpoint '%s'", path);
+        return 1;
+    }
+    
+    char magic[4];
+    uint32_t version = 0;
+    bool ok = read_value(file, magic, sizeof(magic)) && memcmp(magic, CHECKPOINT_MAGIC, 4) == 0 &&
+              read_u32(file, &version);
+    
+    if (ok && version != CHECKPOINT_VERSION) {
+        fclose(file);
+        snprintf(error, error_size, "Erro: checkpoint '%s' gravado por outra versão (%u, esperado %d)",
+                 path, version, CHECKPOINT_VERSION);
+        return 1;
+    }
+    
+    ok = ok && read_value(file, &checkpoint->fingerprint, sizeof(uint64_t)) &&
+         read_value(file, &checkpoint->input_offset, sizeof(uint64_t)) &&
+         read_u32(file, &checkpoint->path_length) && checkpoint->path_length > 0 &&
+         checkpoint->path_length <= 1u << 20;
+    
+    if (ok) {
+        checkpoint->path = (uint32_t*)malloc(checkpoint->path_length * sizeof(uint32_t));
+        ok = read_value(file, checkpoint->path, checkpoint->path_length * sizeof(uint32_t)) &&
+             read_u32(file, &checkpoint->variable_count) && checkpoint->variable_count <= 1u << 24;
+    }
+    
+    if (ok) {
+        checkpoint->variables = (CheckpointVariable*)calloc(checkpoint->variable_count + 1, sizeof(CheckpointVariable));
+    }
+    
+    for (uint32_t i = 0; ok && i < checkpoint->variable_count; i++) {
+        CheckpointVariable* variable = &checkpoint->variables[i];
+        uint32_t name_length;
+        
+        ok = read_u32(file, &name_length) && (variable->name = read_text(file, name_length)) != NULL &&
+             read_u32(file, &variable->type) && variable->type <= CHECKPOINT_STR &&
+             read_u32(file, &variable->depth);
+        
+        if (ok && variable->type == CHECKPOINT_STR) {
+            ok = read_u32(file, &variable->str_length) &&
+                 (variable->str_value = read_text(file, variable->str_length)) != NULL;
+        } else if (ok) {
+            ok = read_value(file, &variable->int_value, sizeof(int32_t));
+        }
+    }
+    
+    fclose(file);
+    
+    if (!ok) {
+        free_checkpoint(checkpoint);
+        snprintf(error, error_size, "Erro: checkpoint '%s' inválido ou incompleto", path);
+        return 1;
+    }
+    
+    return 0;
+}
+
+void free_checkpoint(Checkpoint* checkpoint) {
+    if (checkpoint->variables != NULL) {
+        for (uint32_t i = 0; i < checkpoint->variable_count; i++) {
+            free(checkpoint->variables[i].name);
+            free(checkpoint->variables[i].str_value);
+        }
+    }
+    
+    free(checkpoint->variables);
+    free(checkpoint->path);
+    memset(checkpoint, 0, sizeof(*checkpoint));
+}
@@ -0,0 +1,46 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "llvm_generator.h"
+
+#define CHECKPOINT_MAGIC "TFK\0"
+#define CHECKPOINT_VERSION 1
+
+typedef enum {
+    CHECKPOINT_I32,
+    CHECKPOINT_BOOL,
+    CHECKPOINT_STR
+} CheckpointType;
+
+typedef struct {
+    char* name;
+    uint32_t type;
+    uint32_t depth;
+    int32_t int_value;
+    uint32_t str_length;
+    char* str_value;
+} CheckpointVariable;
+
+typedef struct {
+    uint64_t fingerprint;
+    uint64_t input_offset;
+    uint32_t* path;
+    uint32_t path_length;
+    CheckpointVariable* variables;
+    uint32_t variable_count;
+} Checkpoint;
+
+typedef struct CheckpointMap CheckpointMap;
+
+CheckpointMap* create_checkpoint_map(Node* root, char* error, size_t error_size);
+void free_checkpoint_map(CheckpointMap* map);
+uint64_t checkpoint_fingerprint(const CheckpointMap* map);
+uint32_t* checkpoint_path(const CheckpointMap* map, const Node* node, uint32_t extra, uint32_t* length);
+
+int write_checkpoint(const Checkpoint* checkpoint, const char* path, char* error, size_t error_size);
+int load_checkpoint(const char* path, Checkpoint* checkpoint, char* error, size_t error_size);
+void free_checkpoint(Checkpoint* checkpoint);
+
+#endif
@@ -0,0 +1,476 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "llvm_generator.h"
+#include "llvm_backend.h"
+#include "compile_server.h"
+
+#define SERVER_MAGIC 0x56534654u
+#define SERVER_PROTOCOL_VERSION 2
+#define SERVER_MAX_ARGS 256
+#define SERVER_MAX_STRING PATH_MAX
+#define SERVER_MAX_STDIN (64u << 20)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t argc;
+    uint32_t cwd_length;
+    uint32_t stdin_length;
+} ServerRequest;
+
+typedef struct {
+    int32_t status;
+    uint32_t stdout_length;
+    uint32_t stderr_length;
+} ServerResponse;
+
+typedef struct {
+    int conn;
+    FILE* out;
+    FILE* err;
+    int status;
+} ServerConnection;
+
+static ServerConnection active_connection = {-1, NULL, NULL, 1};
+
+static int write_all(int fd, const void* data, size_t size) {
+    const char* ptr = (const char*)data;
+    
+    while (size > 0) {
+        ssize_t written = write(fd, ptr, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        ptr += written;
+        size -= (size_t)written;
+    }
+    return 0;
+}
+
+static int read_all(int fd, void* data, size_t size) {
+    char* ptr = (char*)data;
+    
+    while (size > 0) {
+        ssize_t count = read(fd, ptr, size);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        if (count == 0) return -1;
+        ptr += count;
+        size -= (size_t)count;
+    }
+    return 0;
+}
+
+static char* read_string(int fd, uint32_t length, uint32_t max_length) {
+    if (length > max_length) return NULL;
+    
+    char* str = (char*)malloc((size_t)length + 1);
+    
+    if (str == NULL || read_all(fd, str, length) != 0) {
+        free(str);
+        return NULL;
+    }
+    
+    str[length] = '\0';
+    return str;
+}
+
+static char* read_stream(FILE* file, size_t* size) {
+    char* data = NULL;
+    size_t capacity = 0;
+    *size = 0;
+    
+    for (;;) {
+        if (*size == capacity) {
+            capacity = capacity == 0 ? 4096 : capacity * 2;
+            char* new_data = (char*)realloc(data, capacity);
+            if (new_data == NULL) {
+                free(data);
+                *size = 0;
+                return NULL;
+            }
+            data = new_data;
+        }
+        
+        size_t count = fread(data + *size, 1, capacity - *size, file);
+        if (count == 0) break;
+        *size += count;
+    }
+    
+    return data;
+}
+
+const char* default_server_socket(void) {
+    static char path[108];
+    const char* env = getenv("TECHFLOW_SOCKET");
+    const char* runtime_dir = getenv("XDG_RUNTIME_DIR");
+    
+    if (env != NULL && env[0] != '\0') {
+        return env;
+    }
+    
+    if (runtime_dir != NULL && runtime_dir[0] == '/' &&
+        snprintf(path, sizeof(path), "%s/techflow.sock", runtime_dir) < (int)sizeof(path)) {
+        return path;
+    }
+    
+    snprintf(path, sizeof(path), "/tmp/techflow-%u/server.sock", (unsigned)getuid());
+    return path;
+}
+
+static bool peer_is_same_user(int fd) {
+    struct ucred credentials;
+    socklen_t length = sizeof(credentials);
+    
+    return getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &credentials, &length) == 0 &&
+           credentials.uid == getuid();
+}
+
+static int prepare_socket_directory(const char* socket_path) {
+    char directory[108];
+    const char* slash = strrchr(socket_path, '/');
+    struct stat st;
+    
+    if (slash == NULL) return 0;
+    
+    size_t length = slash == socket_path ? 1 : (size_t)(slash - socket_path);
+    memcpy(directory, socket_path, length);
+    directory[length] = '\0';
+    
+    if (mkdir(directory, 0700) != 0 && errno != EEXIST) {
+        fprintf(stderr, "Erro: não foi possível criar o diretório do socket %s\n", directory);
+        return -1;
+    }
+    
+    if (lstat(directory, &st) != 0 || !S_ISDIR(st.st_mode) ||
+        (st.st_uid != getuid() && st.st_uid != 0) ||
+        ((st.st_mode & (S_IWGRP | S_IWOTH)) != 0 && (st.st_mode & S_ISVTX) == 0)) {
+        fprintf(stderr, "Erro: diretório do socket %s inseguro: deve pertencer ao usuário e não ser gravável por outros\n",
+                directory);
+        return -1;
+    }
+    return 0;
+}
+
+static int remove_stale_socket(const char* socket_path) {
+    struct stat st;
+    
+    if (lstat(socket_path, &st) != 0) {
+        return errno == ENOENT ? 0 : -1;
+    }
+    
+    if (!S_ISSOCK(st.st_mode) || st.st_uid != getuid()) {
+        fprintf(stderr, "Erro: %s já existe e não é um socket do usuário\n", socket_path);
+        return -1;
+    }
+    return unlink(socket_path);
+}
+
+static void send_response(void) {
+    ServerConnection* connection = &active_connection;
+    ServerResponse response;
+    size_t out_size, err_size;
+    
+    fflush(stdout);
+    fflush(stderr);
+    rewind(connection->out);
+    rewind(connection->err);
+    char* out_data = read_stream(connection->out, &out_size);
+    char* err_data = read_stream(connection->err, &err_size);
+    
+    response.status = connection->status;
+    response.stdout_length = (uint32_t)out_size;
+    response.stderr_length = (uint32_t)err_size;
+    
+    if (write_all(connection->conn, &response, sizeof(response)) == 0 &&
+        write_all(connection->conn, out_data, out_size) == 0) {
+        write_all(connection->conn, err_data, err_size);
+    }
+    
+    free(out_data);
+    free(err_data);
+}
+
+static int run_request(int argc, char* argv[], const char* cwd, FILE* input, FILE* out, FILE* err) {
+    fflush(stdout);
+    fflush(stderr);
+    
+    dup2(fileno(input), STDIN_FILENO);
+    dup2(fileno(out), STDOUT_FILENO);
+    dup2(fileno(err), STDERR_FILENO);
+    
+    if (chdir(cwd) != 0) {
+        fprintf(stderr, "Erro: diretório de trabalho '%s' inacessível\n", cwd);
+        return 1;
+    }
+    
+    return run_command(argc, argv);
+}
+
+static char** read_arguments(int fd, uint32_t argc) {
+    char** argv = (char**)calloc(argc + 1, sizeof(char*));
+    if (argv == NULL) return NULL;
+    
+    for (uint32_t i = 0; i < argc; i++) {
+        uint32_t length;
+        if (read_all(fd, &length, sizeof(length)) != 0 ||
+            (argv[i] = read_string(fd, length, SERVER_MAX_STRING)) == NULL) {
+            for (uint32_t k = 0; k < i; k++) free(argv[k]);
+            free(argv);
+            return NULL;
+        }
+    }
+    
+    return argv;
+}
+
+static void handle_connection(int conn) {
+    ServerRequest request;
+    
+    if (read_all(conn, &request, sizeof(request)) != 0 ||
+        request.magic != SERVER_MAGIC || request.version != SERVER_PROTOCOL_VERSION ||
+        request.argc == 0 || request.argc > SERVER_MAX_ARGS) {
+        return;
+    }
+    
+    char** argv = read_arguments(conn, request.argc);
+    if (argv == NULL) return;
+    
+    char* cwd = read_string(conn, request.cwd_length, SERVER_MAX_STRING);
+    char* stdin_data = read_string(conn, request.stdin_length, SERVER_MAX_STDIN);
+    
+    FILE* input = tmpfile();
+    FILE* out = tmpfile();
+    FILE* err = tmpfile();
+    
+    if (cwd && stdin_data && input && out && err) {
+        fwrite(stdin_data, 1, request.stdin_length, input);
+        fflush(input);
+        rewind(input);
+        
+        active_connection.conn = conn;
+        active_connection.out = out;
+        active_connection.err = err;
+        active_connection.status = 1;
+        atexit(send_response);
+        
+        active_connection.status = run_request((int)request.argc, argv, cwd, input, out, err);
+        exit(active_connection.status);
+    }
+    
+    if (input) fclose(input);
+    if (out) fclose(out);
+    if (err) fclose(err);
+    for (uint32_t i = 0; i < request.argc; i++) free(argv[i]);
+    free(argv);
+    free(cwd);
+    free(stdin_data);
+}
+
+static int open_server_socket(const char* socket_path, int listen_mode) {
+    struct sockaddr_un address;
+    
+    if (strlen(socket_path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Erro: caminho do socket muito longo: %s\n", socket_path);
+        return -1;
+    }
+    
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        perror("socket");
+        return -1;
+    }
+    
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socket_path);
+    
+    if (listen_mode) {
+        if (prepare_socket_directory(socket_path) != 0 || remove_stale_socket(socket_path) != 0) {
+            close(fd);
+            return -1;
+        }
+        
+        mode_t old_mask = umask(0077);
+        int bound = bind(fd, (struct sockaddr*)&address, sizeof(address));
+        umask(old_mask);
+        
+        if (bound != 0 || listen(fd, 64) != 0) {
+            perror("bind");
+            close(fd);
+            return -1;
+        }
+    } else if (connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        fprintf(stderr, "Erro: servidor de compilação indisponível em %s\n", socket_path);
+        close(fd);
+        return -1;
+    } else if (!peer_is_same_user(fd)) {
+        fprintf(stderr, "Erro: o servidor de compilação em %s pertence a outro usuário\n", socket_path);
+        close(fd);
+        return -1;
+    }
+    
+    return fd;
+}
+
+int run_compile_server(const char* socket_path) {
+    char backend_error[256];
+    const LLVMBackend* backend = load_llvm_backend(backend_error, sizeof(backend_error));
+    if (backend != NULL) {
+        CodegenOptions default_options;
+        memset(&default_options, 0, sizeof(default_options));
+        backend->warm_target_machine(&default_options);
+    } else {
+        fprintf(stderr, "%s\n", backend_error);
+    }
+    
+    int server = open_server_socket(socket_path, 1);
+    if (server < 0) return 1;
+    
+    signal(SIGCHLD, SIG_IGN);
+    signal(SIGPIPE, SIG_IGN);
+    
+    printf("Servidor de compilação TechFlow ouvindo em %s\n", socket_path);
+    fflush(stdout);
+    
+    for (;;) {
+        int conn = accept(server, NULL, NULL);
+        if (conn < 0) {
+            if (errno == EINTR) continue;
+            perror("accept");
+            break;
+        }
+        
+        if (!peer_is_same_user(conn)) {
+            close(conn);
+            continue;
+        }
+        
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(server);
+            signal(SIGCHLD, SIG_DFL);
+            handle_connection(conn);
+            close(conn);
+            _exit(0);
+        }
+        
+        close(conn);
+    }
+    
+    close(server);
+    unlink(socket_path);
+    return 1;
+}
+
+static bool forwards_stdin(int argc, char* argv[]) {
+    if (isatty(STDIN_FILENO)) return false;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--compile") == 0 || strcmp(argv[i], "--precompile") == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int write_arguments(int fd, int argc, char* argv[]) {
+    for (int i = 0; i < argc; i++) {
+        uint32_t length = (uint32_t)strlen(argv[i]);
+        if (write_all(fd, &length, sizeof(length)) != 0 || write_all(fd, argv[i], length) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int run_compile_client(const char* socket_path, int argc, char* argv[]) {
+    char cwd[4096];
+    if (getcwd(cwd, sizeof(cwd)) == NULL) {
+        fprintf(stderr, "Erro: não foi possível obter o diretório de trabalho\n");
+        return 1;
+    }
+    
+    if (argc > SERVER_MAX_ARGS) {
+        fprintf(stderr, "Erro: argumentos demais para o servidor de compilação\n");
+        return 1;
+    }
+    
+    for (int i = 0; i < argc; i++) {
+        if (strlen(argv[i]) > SERVER_MAX_STRING) {
+            fprintf(stderr, "Erro: argumento longo demais para o servidor de compilação\n");
+            return 1;
+        }
+    }
+    
+    size_t stdin_size = 0;
+    char* stdin_data = NULL;
+    if (forwards_stdin(argc, argv)) {
+        stdin_data = read_stream(stdin, &stdin_size);
+        if (stdin_size > SERVER_MAX_STDIN) {
+            fprintf(stderr, "Erro: entrada padrão grande demais para o servidor de compilação (máximo de %u MiB)\n",
+                    SERVER_MAX_STDIN >> 20);
+            free(stdin_data);
+            return 1;
+        }
+    }
+    
+    int fd = open_server_socket(socket_path, 0);
+    if (fd < 0) {
+        free(stdin_data);
+        return 1;
+    }
+    
+    ServerRequest request;
+    request.magic = SERVER_MAGIC;
+    request.version = SERVER_PROTOCOL_VERSION;
+    request.argc = (uint32_t)argc;
+    request.cwd_length = (uint32_t)strlen(cwd);
+    request.stdin_length = (uint32_t)stdin_size;
+    
+    ServerResponse response;
+    int ok = write_all(fd, &request, sizeof(request)) == 0 &&
+             write_arguments(fd, argc, argv) == 0 &&
+             write_all(fd, cwd, request.cwd_length) == 0 &&
+             write_all(fd, stdin_data, stdin_size) == 0 &&
+             read_all(fd, &response, sizeof(response)) == 0;
+    free(stdin_data);
+    
+    if (!ok) {
+        fprintf(stderr, "Erro: falha na comunicação com o servidor de compilação\n");
+        close(fd);
+        return 1;
+    }
+    
+    char* out_data = read_string(fd, response.stdout_length, UINT32_MAX);
+    char* err_data = read_string(fd, response.stderr_length, UINT32_MAX);
+    close(fd);
+    
+    if (out_data == NULL || err_data == NULL) {
+        fprintf(stderr, "Erro: resposta incompleta do servidor de compilação\n");
+        free(out_data);
+        free(err_data);
+        return 1;
+    }
+    
+    fwrite(out_data, 1, response.stdout_length, stdout);
+    fwrite(err_data, 1, response.stderr_length, stderr);
+    free(out_data);
+    free(err_data);
+    
+    return response.status;
+}
@@ -0,0 +1,10 @@
+#ifndef COMPILE_SERVER_H
+#define COMPILE_SERVER_H
+
+int run_command(int argc, char* argv[]);
+
+const char* default_server_socket(void);
+int run_compile_server(const char* socket_path);
+int run_compile_client(const char* socket_path, int argc, char* argv[]);
+
+#endif
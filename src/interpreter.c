@@ -2,158 +2,984 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
-#include "llvm_generator.h"
+#include <stdarg.h>
+#include <limits.h>
+#include <setjmp.h>
+#include <pthread.h>
+#include "interpreter.h"
+#include "runtime_support.h"
+#include "mem_stats.h"
+#include "checkpoint.h"
 
-typedef enum {
-    VAL_INT,
-    VAL_STRING,
-    VAL_BOOL
-} ValueType;
+typedef uint64_t Value;
+
+_Static_assert(sizeof(uintptr_t) <= sizeof(Value), "Value precisa comportar um ponteiro");
+
+#define VALUE_TAG_MASK 0x7u
+#define VALUE_TAG_INT 0x1u
+#define VALUE_TAG_BOOL 0x2u
+#define VALUE_TAG_CHANNEL 0x3u
+#define VALUE_STRING_BIT 0x4u
+#define VALUE_TAG_SHORT_STRING 0x4u
+#define VALUE_TAG_HEAP_STRING 0x5u
+#define VALUE_TAG_STATIC_STRING 0x6u
+#define VALUE_STATIC_STRING_SHIFT 16
+#define VALUE_SHORT_STRING_MAX 7
+#define VALUE_TEXT_BUFFER 16
+
+typedef struct {
+    uint32_t refs;
+    uint32_t length;
+    char data[];
+} StringBox;
+
+typedef struct ChannelBox {
+    TFChannel* channel;
+    const char* element_type;
+    struct ChannelBox* next;
+} ChannelBox;
+
+static inline __attribute__((always_inline)) bool value_is_int(Value value) {
+    return (value & VALUE_TAG_MASK) == VALUE_TAG_INT;
+}
+
+static inline __attribute__((always_inline)) bool value_is_bool(Value value) {
+    return (value & VALUE_TAG_MASK) == VALUE_TAG_BOOL;
+}
+
+static inline __attribute__((always_inline)) bool value_is_string(Value value) {
+    return (value & VALUE_STRING_BIT) != 0;
+}
+
+static inline __attribute__((always_inline)) bool value_is_channel(Value value) {
+    return (value & VALUE_TAG_MASK) == VALUE_TAG_CHANNEL;
+}
+
+static inline __attribute__((always_inline)) int value_int(Value value) {
+    return (int32_t)(uint32_t)(value >> 32);
+}
+
+static inline __attribute__((always_inline)) bool value_bool(Value value) {
+    return (value >> 32) != 0;
+}
+
+static inline __attribute__((always_inline)) StringBox* value_box(Value value) {
+    return (StringBox*)(uintptr_t)(value & ~(uint64_t)VALUE_TAG_MASK);
+}
+
+static inline __attribute__((always_inline)) ChannelBox* value_channel(Value value) {
+    return (ChannelBox*)(uintptr_t)(value & ~(uint64_t)VALUE_TAG_MASK);
+}
+
+static inline __attribute__((always_inline)) Value create_int_value(int val) {
+    return ((uint64_t)(uint32_t)val << 32) | VALUE_TAG_INT;
+}
+
+static inline __attribute__((always_inline)) Value create_bool_value(bool val) {
+    return ((uint64_t)val << 32) | VALUE_TAG_BOOL;
+}
+
+static Value create_short_string(const char* str, size_t length) {
+    Value value = VALUE_TAG_SHORT_STRING | ((uint64_t)length << 3);
+    
+    for (size_t i = 0; i < length; i++) {
+        value |= (uint64_t)(unsigned char)str[i] << (8 * (i + 1));
+    }
+    return value;
+}
+
+static Value create_joined_string(const char* left, size_t left_length,
+                                  const char* right, size_t right_length) {
+    size_t length = left_length + right_length;
+    
+    if (length <= VALUE_SHORT_STRING_MAX) {
+        char buffer[VALUE_SHORT_STRING_MAX];
+        memcpy(buffer, left, left_length);
+        memcpy(buffer + left_length, right, right_length);
+        return create_short_string(buffer, length);
+    }
+    
+    StringBox* box = (StringBox*)tf_malloc(sizeof(StringBox) + length + 1);
+    box->refs = 1;
+    box->length = (uint32_t)length;
+    memcpy(box->data, left, left_length);
+    memcpy(box->data + left_length, right, right_length);
+    box->data[length] = '\0';
+    return (Value)(uintptr_t)box | VALUE_TAG_HEAP_STRING;
+}
+
+static Value create_string_value(const char* val) {
+    return create_joined_string(val, strlen(val), "", 0);
+}
+
+static Value create_literal_value(const char* val) {
+    size_t length = strlen(val);
+    
+    if (length <= VALUE_SHORT_STRING_MAX) {
+        return create_short_string(val, length);
+    }
+    if (((uint64_t)(uintptr_t)val >> (64 - VALUE_STATIC_STRING_SHIFT)) != 0) {
+        return create_joined_string(val, length, "", 0);
+    }
+    return ((uint64_t)(uintptr_t)val << VALUE_STATIC_STRING_SHIFT) | VALUE_TAG_STATIC_STRING;
+}
+
+static inline __attribute__((always_inline)) Value retain_value(Value value) {
+    if ((value & VALUE_TAG_MASK) == VALUE_TAG_HEAP_STRING) {
+        __atomic_fetch_add(&value_box(value)->refs, 1, __ATOMIC_RELAXED);
+    }
+    return value;
+}
+
+static inline __attribute__((always_inline)) void release_value(Value value) {
+    if ((value & VALUE_TAG_MASK) == VALUE_TAG_HEAP_STRING &&
+        __atomic_sub_fetch(&value_box(value)->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+        tf_free(value_box(value));
+    }
+}
+
+static const char* value_text(Value value, char* buffer, size_t* length) {
+    switch (value & VALUE_TAG_MASK) {
+        case VALUE_TAG_INT:
+            *length = (size_t)sprintf(buffer, "%d", value_int(value));
+            return buffer;
+        case VALUE_TAG_BOOL:
+            *length = value_bool(value) ? 4 : 5;
+            return value_bool(value) ? "true" : "false";
+        case VALUE_TAG_SHORT_STRING:
+            *length = (value >> 3) & VALUE_TAG_MASK;
+            for (size_t i = 0; i < *length; i++) {
+                buffer[i] = (char)(value >> (8 * (i + 1)));
+            }
+            buffer[*length] = '\0';
+            return buffer;
+        case VALUE_TAG_HEAP_STRING:
+            *length = value_box(value)->length;
+            return value_box(value)->data;
+        default: {
+            const char* str = (const char*)(uintptr_t)(value >> VALUE_STATIC_STRING_SHIFT);
+            *length = strlen(str);
+            return str;
+        }
+    }
+}
+
+static bool check_same_type(Value a, Value b) {
+    return ((a ^ b) & VALUE_TAG_MASK) == 0 || (a & b & VALUE_STRING_BIT) != 0;
+}
+
+static bool strings_equal(Value a, Value b) {
+    if (a == b) return true;
+    if ((a & VALUE_TAG_MASK) == VALUE_TAG_SHORT_STRING ||
+        (b & VALUE_TAG_MASK) == VALUE_TAG_SHORT_STRING) {
+        return false;
+    }
+    
+    char left_buffer[VALUE_TEXT_BUFFER], right_buffer[VALUE_TEXT_BUFFER];
+    size_t left_length, right_length;
+    const char* left = value_text(a, left_buffer, &left_length);
+    const char* right = value_text(b, right_buffer, &right_length);
+    return left_length == right_length && memcmp(left, right, left_length) == 0;
+}
+
+static int compare_strings(Value a, Value b) {
+    if (a == b) return 0;
+    
+    char left_buffer[VALUE_TEXT_BUFFER], right_buffer[VALUE_TEXT_BUFFER];
+    size_t left_length, right_length;
+    const char* left = value_text(a, left_buffer, &left_length);
+    const char* right = value_text(b, right_buffer, &right_length);
+    return strcmp(left, right);
+}
 
 typedef struct {
-    ValueType type;
-    union {
-        int int_val;
-        char* str_val;
-        bool bool_val;
-    } data;
-} Value;
-
-typedef struct Symbol {
-    char* name;
-    char* type;
+    const char* name;
+    const char* type;
     Value value;
-    struct Symbol* next;
+    int depth;
 } Symbol;
 
+#define BUDGET_SLICE 1024
+
+typedef struct {
+    ExecutionLimits limits;
+    uint64_t used_steps;
+    double start_ms;
+    TFMemAccount* memory;
+} ExecutionBudget;
+
 typedef struct {
-    Symbol* first;
+    pthread_mutex_t lock;
+    TFTaskGroup* group;
+    ChannelBox* channels;
+    volatile bool failed;
+    char error[256];
+} TaskState;
+
+typedef struct {
+    CheckpointMap* map;
+    const char* path;
+    uint64_t every;
+    uint64_t countdown;
+} CheckpointState;
+
+typedef struct {
+    Checkpoint checkpoint;
+    uint32_t position;
+    uint32_t next_variable;
+} ResumeState;
+
+typedef struct {
+    FILE* output;
+    TFReader* reader;
+    jmp_buf* error_jump;
+    char* error;
+    size_t error_size;
+    Profile* profile;
+    ExecutionBudget* budget;
+    uint64_t budget_slice;
+    TaskState* tasks;
+    const char* isolated_block;
+    CheckpointState* checkpoint;
+} ExecutionContext;
+
+typedef struct SymbolTable {
+    Symbol* symbols;
+    int count;
+    int capacity;
+    int scope_start;
+    int depth;
+    struct SymbolTable* parent;
+    ExecutionContext* context;
 } SymbolTable;
 
 static SymbolTable* init_symbol_table() {
-    SymbolTable* table = (SymbolTable*)malloc(sizeof(SymbolTable));
-    table->first = NULL;
+    SymbolTable* table = (SymbolTable*)tf_malloc(sizeof(SymbolTable));
+    table->symbols = NULL;
+    table->count = 0;
+    table->capacity = 0;
+    table->scope_start = 0;
+    table->depth = 0;
+    table->parent = NULL;
+    table->context = NULL;
     return table;
 }
 
+static void runtime_error(SymbolTable* table, const char* format, ...) __attribute__((noreturn, format(printf, 2, 3)));
+
+static void runtime_error(SymbolTable* table, const char* format, ...) {
+    ExecutionContext* context = table->context;
+    va_list args;
+    
+    va_start(args, format);
+    vsnprintf(context->error, context->error_size, format, args);
+    va_end(args);
+    
+    longjmp(*context->error_jump, 1);
+}
+
+static void refill_budget(SymbolTable* table) {
+    ExecutionContext* context = table->context;
+    ExecutionBudget* budget = context->budget;
+    uint64_t slice = BUDGET_SLICE;
+    
+    if (budget->limits.max_steps > 0) {
+        uint64_t used = __atomic_fetch_add(&budget->used_steps, slice, __ATOMIC_RELAXED);
+        if (used >= budget->limits.max_steps) {
+            runtime_error(table, "Erro: limite de %llu passos excedido",
+                          (unsigned long long)budget->limits.max_steps);
+        }
+        if (budget->limits.max_steps - used < slice) {
+            slice = budget->limits.max_steps - used;
+        }
+    }
+    
+    if (budget->limits.max_ms > 0 && tf_monotonic_ms() - budget->start_ms > budget->limits.max_ms) {
+        runtime_error(table, "Erro: limite de tempo de %llu ms excedido",
+                      (unsigned long long)budget->limits.max_ms);
+    }
+    
+    if (budget->memory != NULL &&
+        tf_mem_account_live_bytes(budget->memory) > (long long)budget->limits.max_mem) {
+        runtime_error(table, "Erro: limite de memória de %llu bytes excedido",
+                      (unsigned long long)budget->limits.max_mem);
+    }
+    
+    context->budget_slice = slice;
+}
+
+static void* swap_task_account(void* account) {
+    return tf_mem_account_enter((TFMemAccount*)account);
+}
+
+static TFMemAccount* enter_budget_memory(const ExecutionContext* context) {
+    return tf_mem_account_enter(context->budget != NULL ? context->budget->memory : NULL);
+}
+
+static inline void charge_step(SymbolTable* table) {
+    ExecutionContext* context = table->context;
+    
+    if (context->budget == NULL) return;
+    
+    if (context->budget_slice == 0) {
+        refill_budget(table);
+    }
+    context->budget_slice--;
+}
+
+static Symbol* get_local_symbol(SymbolTable* table, const char* name) {
+    for (int i = table->count - 1; i >= 0; i--) {
+        if (strcmp(table->symbols[i].name, name) == 0) {
+            return &table->symbols[i];
+        }
+    }
+    return NULL;
+}
+
 static Symbol* get_symbol(SymbolTable* table, const char* name) {
-    Symbol* current = table->first;
-    while (current != NULL) {
-        if (strcmp(current->name, name) == 0) {
-            return current;
+    while (table != NULL) {
+        Symbol* symbol = get_local_symbol(table, name);
+        if (symbol != NULL) {
+            return symbol;
         }
-        current = current->next;
+        table = table->parent;
     }
     return NULL;
 }
 
 static void set_symbol(SymbolTable* table, const char* name, const char* type, Value value) {
+    for (int i = table->count - 1; i >= table->scope_start; i--) {
+        Symbol* symbol = &table->symbols[i];
+        
+        if (strcmp(symbol->name, name) == 0) {
+            if (symbol->type != type && strcmp(symbol->type, type) != 0) {
+                runtime_error(table, "Erro: Tipo incompatível para variável '%s'", name);
+            }
+            
+            release_value(symbol->value);
+            symbol->value = value;
+            return;
+        }
+    }
+    
+    if (table->count == table->capacity) {
+        table->capacity = table->capacity == 0 ? 16 : table->capacity * 2;
+        table->symbols = (Symbol*)tf_realloc(table->symbols, table->capacity * sizeof(Symbol));
+    }
+    
+    Symbol* symbol = &table->symbols[table->count++];
+    symbol->name = name;
+    symbol->type = type;
+    symbol->value = value;
+    symbol->depth = table->depth;
+}
+
+static int enter_scope(SymbolTable* table) {
+    int saved = table->scope_start;
+    table->scope_start = table->count;
+    table->depth++;
+    return saved;
+}
+
+static void leave_scope(SymbolTable* table, int saved) {
+    for (int i = table->scope_start; i < table->count; i++) {
+        release_value(table->symbols[i].value);
+    }
+    table->count = table->scope_start;
+    table->scope_start = saved;
+    table->depth--;
+}
+
+static void free_symbol_table(SymbolTable* table) {
+    for (int i = 0; i < table->count; i++) {
+        release_value(table->symbols[i].value);
+    }
+    
+    tf_free(table->symbols);
+    tf_free(table);
+}
+
+static Value evaluate_expression(Node* node, SymbolTable* table);
+static void execute_statement(Node* node, SymbolTable* table);
+static void execute_parallel_for(Node* node, SymbolTable* table);
+static void execute_spawn(Node* node, SymbolTable* table);
+static void execute_receive_loop(Node* node, SymbolTable* table);
+static void resume_statement(Node* node, SymbolTable* table, ResumeState* resume);
+
+static bool value_has_type(Value value, const char* type) {
+    if (strcmp(type, "i32") == 0) return value_is_int(value);
+    if (strcmp(type, "bool") == 0) return value_is_bool(value);
+    return value_is_string(value);
+}
+
+static TFTaskGroup* task_group(SymbolTable* table) {
+    TaskState* tasks = table->context->tasks;
+    
+    pthread_mutex_lock(&tasks->lock);
+    if (tasks->group == NULL) {
+        tasks->group = tf_task_group_create();
+    }
+    pthread_mutex_unlock(&tasks->lock);
+    return tasks->group;
+}
+
+static void record_task_error(TaskState* tasks, const char* error) {
+    pthread_mutex_lock(&tasks->lock);
+    if (!tasks->failed) {
+        snprintf(tasks->error, sizeof(tasks->error), "%s", error);
+        tasks->failed = true;
+    }
+    pthread_mutex_unlock(&tasks->lock);
+    
+    tf_task_group_cancel(tasks->group);
+}
+
+static void channel_failure(SymbolTable* table, TFChannelStatus status) __attribute__((noreturn));
+
+static void channel_failure(SymbolTable* table, TFChannelStatus status) {
+    TaskState* tasks = table->context->tasks;
+    
+    if (status == TF_CHANNEL_CLOSED) {
+        runtime_error(table, "Erro: Envio para canal fechado");
+    } else if (status == TF_CHANNEL_DEADLOCK) {
+        runtime_error(table, "Erro: Deadlock: todas as tarefas estão bloqueadas em canais");
+    } else if (tasks->failed) {
+        runtime_error(table, "%s", tasks->error);
+    }
+    runtime_error(table, "Erro: Tarefas canceladas");
+}
+
+static ChannelBox* lookup_channel(SymbolTable* table, const char* name) {
     Symbol* symbol = get_symbol(table, name);
     
-    if (symbol != NULL) {
-        if (strcmp(symbol->type, type) != 0) {
-            fprintf(stderr, "Erro: Tipo incompatível para variável '%s'\n", name);
-            exit(1);
+    if (symbol == NULL) {
+        runtime_error(table, "Erro: Variável '%s' não definida", name);
+    }
+    if (!value_is_channel(symbol->value)) {
+        runtime_error(table, "Erro: Variável '%s' não é um canal", name);
+    }
+    return value_channel(symbol->value);
+}
+
+static void declare_channel(Node* node, SymbolTable* table) {
+    int capacity = TF_CHANNEL_DEFAULT_CAPACITY;
+    
+    if (node->data.channel_decl.capacity != NULL) {
+        Value value = evaluate_expression(node->data.channel_decl.capacity, table);
+        if (!value_is_int(value)) {
+            runtime_error(table, "Erro: Capacidade do canal '%s' deve ser i32", node->data.channel_decl.name);
         }
-        
-        if (symbol->value.type == VAL_STRING && symbol->value.data.str_val != NULL) {
-            free(symbol->value.data.str_val);
+        capacity = value_int(value);
+    }
+    
+    TFChannel* channel = tf_channel_create(task_group(table), capacity);
+    if (channel == NULL) {
+        runtime_error(table, "Erro: Capacidade de canal inválida: %d", capacity);
+    }
+    
+    TaskState* tasks = table->context->tasks;
+    ChannelBox* box = (ChannelBox*)tf_malloc(sizeof(ChannelBox));
+    box->channel = channel;
+    box->element_type = node->data.channel_decl.data_type;
+    
+    pthread_mutex_lock(&tasks->lock);
+    box->next = tasks->channels;
+    tasks->channels = box;
+    pthread_mutex_unlock(&tasks->lock);
+    
+    set_symbol(table, node->data.channel_decl.name, "channel", (Value)(uintptr_t)box | VALUE_TAG_CHANNEL);
+}
+
+static Value receive_value(Node* node, SymbolTable* table) {
+    ChannelBox* box = lookup_channel(table, node->data.channel_op.channel);
+    uint64_t value;
+    TFChannelStatus status = tf_channel_receive(box->channel, &value);
+    
+    if (status == TF_CHANNEL_OK) {
+        return value;
+    }
+    if (status != TF_CHANNEL_CLOSED) {
+        channel_failure(table, status);
+    }
+    
+    if (strcmp(box->element_type, "i32") == 0) {
+        return create_int_value(0);
+    } else if (strcmp(box->element_type, "bool") == 0) {
+        return create_bool_value(false);
+    }
+    return create_string_value("");
+}
+
+static void wait_for_tasks(SymbolTable* table) {
+    TaskState* tasks = table->context->tasks;
+    
+    if (tasks->group == NULL) return;
+    
+    TFChannelStatus status = tf_task_group_wait(tasks->group);
+    if (tasks->failed) {
+        runtime_error(table, "%s", tasks->error);
+    }
+    if (status == TF_CHANNEL_DEADLOCK) {
+        runtime_error(table, "Erro: Deadlock: todas as tarefas estão bloqueadas em canais");
+    }
+}
+
+static void drop_channel_value(uint64_t value) {
+    release_value(value);
+}
+
+static void finish_tasks(TaskState* tasks, bool cancel) {
+    if (tasks->group != NULL) {
+        if (cancel) {
+            tf_task_group_cancel(tasks->group);
+            tf_task_group_wait(tasks->group);
         }
-        
-        symbol->value = value;
-    } else {
-        symbol = (Symbol*)malloc(sizeof(Symbol));
-        symbol->name = strdup(name);
-        symbol->type = strdup(type);
-        symbol->value = value;
-        
-        symbol->next = table->first;
-        table->first = symbol;
+        tf_task_group_destroy(tasks->group, drop_channel_value);
+    }
+    
+    while (tasks->channels != NULL) {
+        ChannelBox* next = tasks->channels->next;
+        tf_free(tasks->channels);
+        tasks->channels = next;
     }
+    pthread_mutex_destroy(&tasks->lock);
 }
 
-static void free_symbol_table(SymbolTable* table) {
-    Symbol* current = table->first;
-    while (current != NULL) {
-        Symbol* next = current->next;
-        
-        free(current->name);
-        free(current->type);
+static int open_checkpoint(Node* root, const InterpreterOptions* options, CheckpointState* checkpoint,
+                           ResumeState* resume, char* error, size_t error_size) {
+    checkpoint->map = create_checkpoint_map(root, error, error_size);
+    if (checkpoint->map == NULL) return 1;
+    
+    checkpoint->path = options->checkpoint_file;
+    checkpoint->every = options->checkpoint_every;
+    checkpoint->countdown = options->checkpoint_every;
+    
+    if (!options->resume) return 0;
+    
+    if (load_checkpoint(checkpoint->path, &resume->checkpoint, error, error_size) != 0) {
+        free_checkpoint_map(checkpoint->map);
+        return 1;
+    }
+    
+    if (resume->checkpoint.fingerprint != checkpoint_fingerprint(checkpoint->map)) {
+        snprintf(error, error_size, "Erro: o checkpoint '%s' não corresponde ao programa", checkpoint->path);
+        free_checkpoint(&resume->checkpoint);
+        free_checkpoint_map(checkpoint->map);
+        return 1;
+    }
+    return 0;
+}
+
+static void save_checkpoint(Node* node, SymbolTable* table) {
+    ExecutionContext* context = table->context;
+    CheckpointState* state = context->checkpoint;
+    Checkpoint checkpoint;
+    
+    checkpoint.fingerprint = checkpoint_fingerprint(state->map);
+    checkpoint.input_offset = tf_reader_offset(context->reader);
+    checkpoint.path = checkpoint_path(state->map, node, 0, &checkpoint.path_length);
+    checkpoint.variable_count = (uint32_t)table->count;
+    checkpoint.variables = (CheckpointVariable*)tf_calloc(table->count + 1, sizeof(CheckpointVariable));
+    
+    for (int i = 0; i < table->count; i++) {
+        Symbol* symbol = &table->symbols[i];
+        CheckpointVariable* variable = &checkpoint.variables[i];
+        variable->name = (char*)symbol->name;
+        variable->depth = (uint32_t)symbol->depth;
         
-        if (current->value.type == VAL_STRING && current->value.data.str_val != NULL) {
-            free(current->value.data.str_val);
+        if (value_is_int(symbol->value)) {
+            variable->type = CHECKPOINT_I32;
+            variable->int_value = value_int(symbol->value);
+        } else if (value_is_bool(symbol->value)) {
+            variable->type = CHECKPOINT_BOOL;
+            variable->int_value = value_bool(symbol->value);
+        } else {
+            char buffer[VALUE_TEXT_BUFFER];
+            size_t length;
+            const char* text = value_text(symbol->value, buffer, &length);
+            variable->type = CHECKPOINT_STR;
+            variable->str_length = (uint32_t)length;
+            variable->str_value = (char*)tf_malloc(length + 1);
+            memcpy(variable->str_value, text, length + 1);
         }
-        
-        free(current);
-        current = next;
     }
     
-    free(table);
+    if (context->output == stdout) {
+        tf_output_flush();
+    }
+    fflush(context->output);
+    
+    char error[256];
+    int status = write_checkpoint(&checkpoint, state->path, error, sizeof(error));
+    
+    for (int i = 0; i < table->count; i++) {
+        tf_free(checkpoint.variables[i].str_value);
+    }
+    tf_free(checkpoint.variables);
+    free(checkpoint.path);
+    
+    if (status != 0) {
+        runtime_error(table, "%s", error);
+    }
 }
 
-static Value create_int_value(int val) {
-    Value value;
-    value.type = VAL_INT;
-    value.data.int_val = val;
-    return value;
+static inline void checkpoint_tick(Node* node, SymbolTable* table) {
+    CheckpointState* state = table->context->checkpoint;
+    
+    if (state == NULL || table->parent != NULL || --state->countdown > 0) return;
+    
+    state->countdown = state->every;
+    save_checkpoint(node, table);
 }
 
-static Value create_string_value(const char* val) {
-    Value value;
-    value.type = VAL_STRING;
-    value.data.str_val = strdup(val);
-    return value;
+int interpret_program(Node* root, FILE* input, FILE* output, const InterpreterOptions* options,
+                      char* error, size_t error_size) {
+    if (root == NULL || root->type != NODE_PROGRAM) {
+        snprintf(error, error_size, "Erro: Raiz da AST inválida");
+        return 1;
+    }
+    
+    CheckpointState checkpoint = { NULL, NULL, 0, 0 };
+    ResumeState resume;
+    memset(&resume, 0, sizeof(resume));
+    
+    if (options != NULL && (options->checkpoint_every > 0 || options->resume)) {
+        if (open_checkpoint(root, options, &checkpoint, &resume, error, error_size) != 0) {
+            return 1;
+        }
+    }
+    
+    jmp_buf error_jump;
+    ExecutionContext context;
+    context.output = output;
+    context.reader = tf_reader_open(input);
+    context.error_jump = &error_jump;
+    context.error = error;
+    context.error_size = error_size;
+    context.profile = options != NULL ? options->profile : NULL;
+    context.budget = NULL;
+    context.budget_slice = 0;
+    context.isolated_block = NULL;
+    context.checkpoint = checkpoint.every > 0 ? &checkpoint : NULL;
+    
+    TaskState tasks;
+    pthread_mutex_init(&tasks.lock, NULL);
+    tasks.group = NULL;
+    tasks.channels = NULL;
+    tasks.failed = false;
+    tasks.error[0] = '\0';
+    context.tasks = &tasks;
+    tf_task_set_local_swap(swap_task_account);
+    
+    ExecutionBudget budget;
+    if (options != NULL && (options->limits.max_steps > 0 || options->limits.max_ms > 0 ||
+                            options->limits.max_mem > 0)) {
+        budget.limits = options->limits;
+        budget.used_steps = 0;
+        budget.start_ms = tf_monotonic_ms();
+        budget.memory = options->limits.max_mem > 0 ? tf_mem_account_create() : NULL;
+        context.budget = &budget;
+    }
+    TFMemAccount* previous_account = enter_budget_memory(&context);
+    
+    SymbolTable* table = init_symbol_table();
+    table->context = &context;
+    
+    fflush(output);
+    
+    int status = 0;
+    if (setjmp(error_jump) == 0) {
+        if (options != NULL && options->resume) {
+            if (resume.checkpoint.input_offset > 0 &&
+                !tf_reader_skip(context.reader, (size_t)resume.checkpoint.input_offset)) {
+                runtime_error(table, "Erro: a entrada terminou antes da posição gravada no checkpoint");
+            }
+            resume_statement(root->data.program.body, table, &resume);
+        } else {
+            execute_statement(root->data.program.body, table);
+        }
+        wait_for_tasks(table);
+    } else {
+        status = 1;
+    }
+    
+    finish_tasks(&tasks, status != 0);
+    
+    if (output == stdout) {
+        tf_output_flush();
+    }
+    fflush(output);
+    free_symbol_table(table);
+    tf_reader_close(context.reader);
+    tf_mem_account_leave(previous_account);
+    if (context.budget != NULL) {
+        tf_mem_account_release(budget.memory);
+    }
+    
+    if (status == 0 && checkpoint.path != NULL) {
+        remove(checkpoint.path);
+    }
+    free_checkpoint_map(checkpoint.map);
+    free_checkpoint(&resume.checkpoint);
+    return status;
 }
 
-static Value create_bool_value(bool val) {
-    Value value;
-    value.type = VAL_BOOL;
-    value.data.bool_val = val;
-    return value;
+void execute_ast(Node* root, const InterpreterOptions* options) {
+    char error[256];
+    
+    if (interpret_program(root, stdin, stdout, options, error, sizeof(error)) != 0) {
+        fprintf(stderr, "%s\n", error);
+        exit(1);
+    }
 }
 
-static char* value_to_string(Value value) {
-    char buffer[256];
+static bool reads_input(Node* node) {
+    if (node == NULL) return false;
     
-    switch (value.type) {
-        case VAL_INT:
-            sprintf(buffer, "%d", value.data.int_val);
-            break;
-        case VAL_STRING:
-            return strdup(value.data.str_val);
-        case VAL_BOOL:
-            return strdup(value.data.bool_val ? "true" : "false");
+    switch (node->type) {
+        case NODE_READ:
+            return true;
+        case NODE_BLOCK:
+            for (int i = 0; i < node->data.block.stmt_count; i++) {
+                if (reads_input(node->data.block.statements[i])) return true;
+            }
+            return false;
+        case NODE_VAR_DECL:
+            return reads_input(node->data.var_decl.init_expr);
+        case NODE_ASSIGN:
+            return reads_input(node->data.assign.value);
+        case NODE_IF:
+            return reads_input(node->data.if_stmt.condition) ||
+                   reads_input(node->data.if_stmt.then_branch) ||
+                   reads_input(node->data.if_stmt.else_branch);
+        case NODE_WHILE:
+            return reads_input(node->data.while_stmt.condition) || reads_input(node->data.while_stmt.body);
+        case NODE_REPEAT:
+            return reads_input(node->data.repeat_stmt.body) || reads_input(node->data.repeat_stmt.condition);
+        case NODE_SWITCH:
+            for (int i = 0; i < node->data.switch_stmt.case_count; i++) {
+                if (reads_input(node->data.switch_stmt.cases[i])) return true;
+            }
+            return reads_input(node->data.switch_stmt.condition) ||
+                   reads_input(node->data.switch_stmt.default_case);
+        case NODE_CASE:
+            return reads_input(node->data.case_stmt.value) || reads_input(node->data.case_stmt.body);
+        case NODE_PRINT:
+            return reads_input(node->data.print_stmt.expr);
+        case NODE_BINARY_OP:
+            return reads_input(node->data.binary_op.left) || reads_input(node->data.binary_op.right);
+        case NODE_UNARY_OP:
+            return reads_input(node->data.unary_op.operand);
+        case NODE_PARALLEL_FOR:
+            return reads_input(node->data.parallel_for.start) || reads_input(node->data.parallel_for.end) ||
+                   reads_input(node->data.parallel_for.body);
+        case NODE_SPAWN:
+        case NODE_CHANNEL_DECL:
+        case NODE_SEND:
+        case NODE_RECEIVE:
+        case NODE_CLOSE:
+        case NODE_RECEIVE_LOOP:
+            return true;
         default:
-            return strdup("");
+            return false;
     }
+}
+
+static void collect_precomputed_variables(SymbolTable* table, PrecomputedPrefix* prefix) {
+    int count = table->count;
+    
+    prefix->variables = count > 0 ? (PrecomputedVariable*)tf_malloc(count * sizeof(PrecomputedVariable)) : NULL;
+    prefix->variable_count = count;
     
-    return strdup(buffer);
+    for (int i = 0; i < count; i++) {
+        Symbol* symbol = &table->symbols[i];
+        PrecomputedVariable* variable = &prefix->variables[i];
+        variable->name = tf_strdup(symbol->name);
+        variable->type = tf_strdup(symbol->type);
+        variable->int_value = 0;
+        variable->str_value = NULL;
+        
+        if (value_is_int(symbol->value)) {
+            variable->int_value = value_int(symbol->value);
+        } else if (value_is_bool(symbol->value)) {
+            variable->int_value = value_bool(symbol->value);
+        } else {
+            char buffer[VALUE_TEXT_BUFFER];
+            size_t length;
+            const char* text = value_text(symbol->value, buffer, &length);
+            variable->str_value = (char*)tf_malloc(length + 1);
+            memcpy(variable->str_value, text, length + 1);
+        }
+    }
 }
 
-static bool check_same_type(Value a, Value b) {
-    return a.type == b.type;
+static int run_prefix(Node** statements, int count, const ExecutionLimits* limits, PrecomputedPrefix* prefix) {
+    char* output = NULL;
+    size_t output_size = 0;
+    FILE* stream = open_memstream(&output, &output_size);
+    if (stream == NULL) return 0;
+    
+    jmp_buf error_jump;
+    char error[256];
+    ExecutionBudget budget = { *limits, 0, tf_monotonic_ms(), limits->max_mem > 0 ? tf_mem_account_create() : NULL };
+    ExecutionContext context;
+    context.output = stream;
+    context.reader = NULL;
+    context.error_jump = &error_jump;
+    context.error = error;
+    context.error_size = sizeof(error);
+    context.profile = NULL;
+    context.budget = &budget;
+    context.budget_slice = 0;
+    context.tasks = NULL;
+    context.isolated_block = NULL;
+    context.checkpoint = NULL;
+    
+    TFMemAccount* previous_account = enter_budget_memory(&context);
+    SymbolTable* table = init_symbol_table();
+    table->context = &context;
+    
+    volatile int completed = 0;
+    if (setjmp(error_jump) == 0) {
+        while (completed < count) {
+            execute_statement(statements[completed], table);
+            completed++;
+        }
+    }
+    
+    fclose(stream);
+    
+    if (completed == count) {
+        prefix->statement_count = count;
+        prefix->output = output;
+        prefix->output_size = output_size;
+        collect_precomputed_variables(table, prefix);
+    } else {
+        free(output);
+    }
+    
+    free_symbol_table(table);
+    tf_mem_account_leave(previous_account);
+    tf_mem_account_release(budget.memory);
+    return completed;
 }
 
-static Value evaluate_expression(Node* node, SymbolTable* table);
-static void execute_statement(Node* node, SymbolTable* table);
+int precompute_prefix(Node* body, const ExecutionLimits* limits, PrecomputedPrefix* prefix) {
+    memset(prefix, 0, sizeof(*prefix));
+    
+    if (body == NULL || body->type != NODE_BLOCK) return 0;
+    
+    int count = 0;
+    while (count < body->data.block.stmt_count && !reads_input(body->data.block.statements[count])) {
+        count++;
+    }
+    
+    while (count > 0) {
+        int completed = run_prefix(body->data.block.statements, count, limits, prefix);
+        if (completed == count) break;
+        count = completed;
+    }
+    
+    return count;
+}
+
+void free_precomputed_prefix(PrecomputedPrefix* prefix) {
+    for (int i = 0; i < prefix->variable_count; i++) {
+        tf_free(prefix->variables[i].name);
+        tf_free(prefix->variables[i].type);
+        tf_free(prefix->variables[i].str_value);
+    }
+    tf_free(prefix->variables);
+    free(prefix->output);
+    memset(prefix, 0, sizeof(*prefix));
+}
 
-void execute_ast(Node* root) {
-    if (root == NULL || root->type != NODE_PROGRAM) {
-        fprintf(stderr, "Erro: Raiz da AST inválida\n");
-        return;
+static Value evaluate_binary_op(const char* op, Value left, Value right, SymbolTable* table) {
+    if (strcmp(op, "CONCAT") == 0) {
+        char left_buffer[VALUE_TEXT_BUFFER], right_buffer[VALUE_TEXT_BUFFER];
+        size_t left_length, right_length;
+        const char* left_str = value_text(left, left_buffer, &left_length);
+        const char* right_str = value_text(right, right_buffer, &right_length);
+        ExecutionBudget* budget = table->context->budget;
+        
+        if (budget != NULL && budget->limits.max_mem > 0 &&
+            left_length + right_length > budget->limits.max_mem) {
+            runtime_error(table, "Erro: limite de memória de %llu bytes excedido",
+                          (unsigned long long)budget->limits.max_mem);
+        }
+        
+        return create_joined_string(left_str, left_length, right_str, right_length);
     }
     
-    SymbolTable* table = init_symbol_table();
-    execute_statement(root->data.program.body, table);
-    free_symbol_table(table);
+    if (!check_same_type(left, right)) {
+        runtime_error(table, "Erro: Operação com tipos incompatíveis");
+    }
+    
+    if (value_is_int(left)) {
+        int a = value_int(left);
+        int b = value_int(right);
+        
+        if (strcmp(op, "+") == 0) {
+            return create_int_value(a + b);
+        } else if (strcmp(op, "-") == 0) {
+            return create_int_value(a - b);
+        } else if (strcmp(op, "*") == 0) {
+            return create_int_value(a * b);
+        } else if (strcmp(op, "/") == 0) {
+            if (b == 0) {
+                runtime_error(table, "Erro: Divisão por zero");
+            }
+            if (a == INT_MIN && b == -1) {
+                runtime_error(table, "Erro: Estouro na divisão de %d por -1", a);
+            }
+            return create_int_value(a / b);
+        } else if (strcmp(op, "%") == 0) {
+            if (b == 0) {
+                runtime_error(table, "Erro: Módulo por zero");
+            }
+            if (a == INT_MIN && b == -1) {
+                runtime_error(table, "Erro: Estouro no módulo de %d por -1", a);
+            }
+            return create_int_value(a % b);
+        } else if (strcmp(op, "<") == 0) {
+            return create_bool_value(a < b);
+        } else if (strcmp(op, ">") == 0) {
+            return create_bool_value(a > b);
+        } else if (strcmp(op, "LE") == 0) {
+            return create_bool_value(a <= b);
+        } else if (strcmp(op, "GE") == 0) {
+            return create_bool_value(a >= b);
+        } else if (strcmp(op, "EQ") == 0) {
+            return create_bool_value(a == b);
+        } else if (strcmp(op, "NEQ") == 0) {
+            return create_bool_value(a != b);
+        }
+    } else if (value_is_string(left)) {
+        if (strcmp(op, "EQ") == 0) {
+            return create_bool_value(strings_equal(left, right));
+        } else if (strcmp(op, "NEQ") == 0) {
+            return create_bool_value(!strings_equal(left, right));
+        } else if (strcmp(op, "<") == 0) {
+            return create_bool_value(compare_strings(left, right) < 0);
+        } else if (strcmp(op, ">") == 0) {
+            return create_bool_value(compare_strings(left, right) > 0);
+        } else if (strcmp(op, "LE") == 0) {
+            return create_bool_value(compare_strings(left, right) <= 0);
+        } else if (strcmp(op, "GE") == 0) {
+            return create_bool_value(compare_strings(left, right) >= 0);
+        }
+    } else if (strcmp(op, "EQ") == 0) {
+        return create_bool_value(left == right);
+    } else if (strcmp(op, "NEQ") == 0) {
+        return create_bool_value(left != right);
+    }
+    
+    runtime_error(table, "Erro: Operador '%s' não suportado para os tipos dados", op);
 }
 
 static Value evaluate_expression(Node* node, SymbolTable* table) {
     if (node == NULL) {
-        Value null_value;
-        null_value.type = VAL_INT;
-        null_value.data.int_val = 0;
-        return null_value;
+        return create_int_value(0);
     }
     
     switch (node->type) {
@@ -162,164 +988,149 @@ static Value evaluate_expression(Node* node, SymbolTable* table) {
         }
         
         case NODE_STRING_VAL: {
-            return create_string_value(node->data.str_value);
+            return create_literal_value(node->data.str_value);
         }
         
         case NODE_BOOL_VAL: {
             return create_bool_value(node->data.bool_value);
         }
         
+        case NODE_READ: {
+            if (table->context->isolated_block != NULL &&
+                strcmp(table->context->isolated_block, "stream parallel") == 0) {
+                runtime_error(table, "Erro: reader não pode ser usado dentro de stream parallel");
+            }
+            
+            TFReader* reader = table->context->reader;
+            if (strcmp(node->data.read_expr.data_type, "str") == 0) {
+                const char* line;
+                tf_reader_lock(reader);
+                tf_reader_read_line(reader, &line);
+                Value value = create_string_value(line);
+                tf_reader_unlock(reader);
+                return value;
+            }
+            
+            int read_value;
+            tf_reader_lock(reader);
+            TFReadStatus status = tf_reader_read_i32(reader, &read_value);
+            tf_reader_unlock(reader);
+            if (status == TF_READ_INVALID) {
+                runtime_error(table, "Erro: Valor inválido para reader");
+            } else if (status == TF_READ_OUT_OF_RANGE) {
+                runtime_error(table, "Erro: Valor fora do intervalo de i32 em reader");
+            }
+            return create_int_value(read_value);
+        }
+        
         case NODE_IDENTIFIER: {
             Symbol* symbol = get_symbol(table, node->data.str_value);
             if (symbol == NULL) {
-                fprintf(stderr, "Erro: Variável '%s' não definida\n", node->data.str_value);
-                exit(1);
+                runtime_error(table, "Erro: Variável '%s' não definida", node->data.str_value);
+            }
+            if (value_is_channel(symbol->value)) {
+                runtime_error(table, "Erro: Canal '%s' só pode ser usado em send, receive, close e stream", 
+                        node->data.str_value);
             }
-            return symbol->value;
+            return retain_value(symbol->value);
+        }
+        
+        case NODE_RECEIVE: {
+            return receive_value(node, table);
         }
         
         case NODE_BINARY_OP: {
-            Value left = evaluate_expression(node->data.binary_op.left, table);
-            Value right = evaluate_expression(node->data.binary_op.right, table);
-            Value result;
-            
-            if (strcmp(node->data.binary_op.operator, "CONCAT") == 0) {
-                char* left_str = value_to_string(left);
-                char* right_str = value_to_string(right);
-                
-                char* result_str = (char*)malloc(strlen(left_str) + strlen(right_str) + 1);
-                strcpy(result_str, left_str);
-                strcat(result_str, right_str);
+            if (strcmp(node->data.binary_op.operator, "AND") == 0 ||
+                strcmp(node->data.binary_op.operator, "OR") == 0) {
+                bool is_and = strcmp(node->data.binary_op.operator, "AND") == 0;
+                Value left = evaluate_expression(node->data.binary_op.left, table);
                 
-                free(left_str);
-                free(right_str);
-                
-                result = create_string_value(result_str);
-                free(result_str);
-                return result;
-            }
-            
-            if (!check_same_type(left, right)) {
-                fprintf(stderr, "Erro: Operação com tipos incompatíveis\n");
-                exit(1);
-            }
-            
-            if (left.type == VAL_INT && right.type == VAL_INT) {
-                if (strcmp(node->data.binary_op.operator, "+") == 0) {
-                    return create_int_value(left.data.int_val + right.data.int_val);
-                } else if (strcmp(node->data.binary_op.operator, "-") == 0) {
-                    return create_int_value(left.data.int_val - right.data.int_val);
-                } else if (strcmp(node->data.binary_op.operator, "*") == 0) {
-                    return create_int_value(left.data.int_val * right.data.int_val);
-                } else if (strcmp(node->data.binary_op.operator, "/") == 0) {
-                    if (right.data.int_val == 0) {
-                        fprintf(stderr, "Erro: Divisão por zero\n");
-                        exit(1);
-                    }
-                    return create_int_value(left.data.int_val / right.data.int_val);
-                } else if (strcmp(node->data.binary_op.operator, "%") == 0) {
-                    if (right.data.int_val == 0) {
-                        fprintf(stderr, "Erro: Módulo por zero\n");
-                        exit(1);
-                    }
-                    return create_int_value(left.data.int_val % right.data.int_val);
-                }
-            }
-            
-            if (strcmp(node->data.binary_op.operator, "<") == 0) {
-                if (left.type == VAL_INT && right.type == VAL_INT) {
-                    return create_bool_value(left.data.int_val < right.data.int_val);
-                } else if (left.type == VAL_STRING && right.type == VAL_STRING) {
-                    return create_bool_value(strcmp(left.data.str_val, right.data.str_val) < 0);
-                }
-            } else if (strcmp(node->data.binary_op.operator, ">") == 0) {
-                if (left.type == VAL_INT && right.type == VAL_INT) {
-                    return create_bool_value(left.data.int_val > right.data.int_val);
-                } else if (left.type == VAL_STRING && right.type == VAL_STRING) {
-                    return create_bool_value(strcmp(left.data.str_val, right.data.str_val) > 0);
-                }
-            } else if (strcmp(node->data.binary_op.operator, "LE") == 0) {
-                if (left.type == VAL_INT && right.type == VAL_INT) {
-                    return create_bool_value(left.data.int_val <= right.data.int_val);
-                } else if (left.type == VAL_STRING && right.type == VAL_STRING) {
-                    return create_bool_value(strcmp(left.data.str_val, right.data.str_val) <= 0);
+                if (!value_is_bool(left)) {
+                    runtime_error(table, "Erro: Operador '%s' requer operandos bool", 
+                            node->data.binary_op.operator);
                 }
-            } else if (strcmp(node->data.binary_op.operator, "GE") == 0) {
-                if (left.type == VAL_INT && right.type == VAL_INT) {
-                    return create_bool_value(left.data.int_val >= right.data.int_val);
-                } else if (left.type == VAL_STRING && right.type == VAL_STRING) {
-                    return create_bool_value(strcmp(left.data.str_val, right.data.str_val) >= 0);
+                
+                if (is_and && !value_bool(left)) {
+                    return create_bool_value(false);
                 }
-            }
-            
-            if (strcmp(node->data.binary_op.operator, "EQ") == 0) {
-                if (left.type == VAL_INT && right.type == VAL_INT) {
-                    return create_bool_value(left.data.int_val == right.data.int_val);
-                } else if (left.type == VAL_STRING && right.type == VAL_STRING) {
-                    return create_bool_value(strcmp(left.data.str_val, right.data.str_val) == 0);
-                } else if (left.type == VAL_BOOL && right.type == VAL_BOOL) {
-                    return create_bool_value(left.data.bool_val == right.data.bool_val);
+                if (!is_and && value_bool(left)) {
+                    return create_bool_value(true);
                 }
-            } else if (strcmp(node->data.binary_op.operator, "NEQ") == 0) {
-                if (left.type == VAL_INT && right.type == VAL_INT) {
-                    return create_bool_value(left.data.int_val != right.data.int_val);
-                } else if (left.type == VAL_STRING && right.type == VAL_STRING) {
-                    return create_bool_value(strcmp(left.data.str_val, right.data.str_val) != 0);
-                } else if (left.type == VAL_BOOL && right.type == VAL_BOOL) {
-                    return create_bool_value(left.data.bool_val != right.data.bool_val);
+                
+                Value right = evaluate_expression(node->data.binary_op.right, table);
+                
+                if (!value_is_bool(right)) {
+                    runtime_error(table, "Erro: Operador '%s' requer operandos bool", 
+                            node->data.binary_op.operator);
                 }
+                
+                return right;
             }
             
-            if (left.type == VAL_BOOL && right.type == VAL_BOOL) {
-                if (strcmp(node->data.binary_op.operator, "AND") == 0) {
-                    return create_bool_value(left.data.bool_val && right.data.bool_val);
-                } else if (strcmp(node->data.binary_op.operator, "OR") == 0) {
-                    return create_bool_value(left.data.bool_val || right.data.bool_val);
-                }
-            }
+            Value left = evaluate_expression(node->data.binary_op.left, table);
+            Value right = evaluate_expression(node->data.binary_op.right, table);
+            Value result = evaluate_binary_op(node->data.binary_op.operator, left, right, table);
             
-            fprintf(stderr, "Erro: Operador '%s' não suportado para os tipos dados\n", 
-                    node->data.binary_op.operator);
-            exit(1);
+            release_value(left);
+            release_value(right);
+            return result;
         }
         
         case NODE_UNARY_OP: {
             Value operand = evaluate_expression(node->data.unary_op.operand, table);
             
             if (strcmp(node->data.unary_op.operator, "+") == 0) {
-                if (operand.type != VAL_INT) {
-                    fprintf(stderr, "Erro: Operador unário '+' requer operando i32\n");
-                    exit(1);
+                if (!value_is_int(operand)) {
+                    runtime_error(table, "Erro: Operador unário '+' requer operando i32");
                 }
                 return operand;
             } else if (strcmp(node->data.unary_op.operator, "-") == 0) {
-                if (operand.type != VAL_INT) {
-                    fprintf(stderr, "Erro: Operador unário '-' requer operando i32\n");
-                    exit(1);
+                if (!value_is_int(operand)) {
+                    runtime_error(table, "Erro: Operador unário '-' requer operando i32");
                 }
-                return create_int_value(-operand.data.int_val);
+                return create_int_value(-value_int(operand));
             } else if (strcmp(node->data.unary_op.operator, "not") == 0) {
-                if (operand.type != VAL_BOOL) {
-                    fprintf(stderr, "Erro: Operador 'not' requer operando bool\n");
-                    exit(1);
+                if (!value_is_bool(operand)) {
+                    runtime_error(table, "Erro: Operador 'not' requer operando bool");
                 }
-                return create_bool_value(!operand.data.bool_val);
+                return create_bool_value(!value_bool(operand));
             }
             
-            fprintf(stderr, "Erro: Operador unário '%s' não suportado\n", 
+            runtime_error(table, "Erro: Operador unário '%s' não suportado", 
                     node->data.unary_op.operator);
-            exit(1);
         }
         
         default:
-            fprintf(stderr, "Erro: Tipo de nó inesperado na expressão\n");
-            exit(1);
+            runtime_error(table, "Erro: Tipo de nó inesperado na expressão");
+    }
+    
+    return create_int_value(0);
+}
+
+static bool finish_repeat_iteration(Node* node, SymbolTable* table, int scope) {
+    Value condition = evaluate_expression(node->data.repeat_stmt.condition, table);
+    leave_scope(table, scope);
+    
+    if (!value_is_bool(condition)) {
+        runtime_error(table, "Erro: Condição do repeat-until deve ser booleana");
+    }
+    
+    if (table->context->profile != NULL) {
+        profile_count(table->context->profile, node, value_bool(condition) ? 1 : 0);
+    }
+    
+    return value_bool(condition);
+}
+
+static void execute_statements(Node* node, SymbolTable* table) {
+    if (node == NULL || node->type != NODE_BLOCK) {
+        execute_statement(node, table);
+        return;
     }
     
-    Value null_value;
-    null_value.type = VAL_INT;
-    null_value.data.int_val = 0;
-    return null_value;
+    for (int i = 0; i < node->data.block.stmt_count; i++) {
+        execute_statement(node->data.block.statements[i], table);
+    }
 }
 
 static void execute_statement(Node* node, SymbolTable* table) {
@@ -327,9 +1138,9 @@ static void execute_statement(Node* node, SymbolTable* table) {
     
     switch (node->type) {
         case NODE_BLOCK: {
-            for (int i = 0; i < node->data.block.stmt_count; i++) {
-                execute_statement(node->data.block.statements[i], table);
-            }
+            int scope = enter_scope(table);
+            execute_statements(node, table);
+            leave_scope(table, scope);
             break;
         }
         
@@ -340,22 +1151,19 @@ static void execute_statement(Node* node, SymbolTable* table) {
                 init_value = evaluate_expression(node->data.var_decl.init_expr, table);
                 
                 if (strcmp(node->data.var_decl.data_type, "i32") == 0) {
-                    if (init_value.type != VAL_INT) {
-                        fprintf(stderr, "Erro: Tipo incompatível na inicialização de '%s'\n", 
+                    if (!value_is_int(init_value)) {
+                        runtime_error(table, "Erro: Tipo incompatível na inicialização de '%s'", 
                                 node->data.var_decl.name);
-                        exit(1);
                     }
                 } else if (strcmp(node->data.var_decl.data_type, "bool") == 0) {
-                    if (init_value.type != VAL_BOOL) {
-                        fprintf(stderr, "Erro: Tipo incompatível na inicialização de '%s'\n", 
+                    if (!value_is_bool(init_value)) {
+                        runtime_error(table, "Erro: Tipo incompatível na inicialização de '%s'", 
                                 node->data.var_decl.name);
-                        exit(1);
                     }
                 } else if (strcmp(node->data.var_decl.data_type, "str") == 0) {
-                    if (init_value.type != VAL_STRING) {
-                        fprintf(stderr, "Erro: Tipo incompatível na inicialização de '%s'\n", 
+                    if (!value_is_string(init_value)) {
+                        runtime_error(table, "Erro: Tipo incompatível na inicialização de '%s'", 
                                 node->data.var_decl.name);
-                        exit(1);
                     }
                 }
             } else {
@@ -366,9 +1174,8 @@ static void execute_statement(Node* node, SymbolTable* table) {
                 } else if (strcmp(node->data.var_decl.data_type, "str") == 0) {
                     init_value = create_string_value("");
                 } else {
-                    fprintf(stderr, "Erro: Tipo desconhecido '%s'\n", 
+                    runtime_error(table, "Erro: Tipo desconhecido '%s'", 
                             node->data.var_decl.data_type);
-                    exit(1);
                 }
             }
             
@@ -381,23 +1188,27 @@ static void execute_statement(Node* node, SymbolTable* table) {
             Symbol* symbol = get_symbol(table, node->data.assign.name);
             
             if (symbol == NULL) {
-                fprintf(stderr, "Erro: Variável '%s' não definida\n", 
+                runtime_error(table, "Erro: Variável '%s' não definida", 
                         node->data.assign.name);
-                exit(1);
             }
             
-            if ((strcmp(symbol->type, "i32") == 0 && value.type != VAL_INT) ||
-                (strcmp(symbol->type, "bool") == 0 && value.type != VAL_BOOL) ||
-                (strcmp(symbol->type, "str") == 0 && value.type != VAL_STRING)) {
-                fprintf(stderr, "Erro: Tipo incompatível na atribuição de '%s'\n", 
-                        node->data.assign.name);
-                exit(1);
+            if (table->parent != NULL && get_local_symbol(table, node->data.assign.name) == NULL) {
+                runtime_error(table, "Erro: Variável '%s' não pode ser modificada dentro de %s", 
+                        node->data.assign.name, table->context->isolated_block);
+            }
+            
+            if (strcmp(symbol->type, "channel") == 0) {
+                runtime_error(table, "Erro: Canal '%s' não pode ser reatribuído", node->data.assign.name);
             }
             
-            if (symbol->value.type == VAL_STRING && symbol->value.data.str_val != NULL) {
-                free(symbol->value.data.str_val);
+            if ((strcmp(symbol->type, "i32") == 0 && !value_is_int(value)) ||
+                (strcmp(symbol->type, "bool") == 0 && !value_is_bool(value)) ||
+                (strcmp(symbol->type, "str") == 0 && !value_is_string(value))) {
+                runtime_error(table, "Erro: Tipo incompatível na atribuição de '%s'", 
+                        node->data.assign.name);
             }
             
+            release_value(symbol->value);
             symbol->value = value;
             break;
         }
@@ -405,12 +1216,15 @@ static void execute_statement(Node* node, SymbolTable* table) {
         case NODE_IF: {
             Value condition = evaluate_expression(node->data.if_stmt.condition, table);
             
-            if (condition.type != VAL_BOOL) {
-                fprintf(stderr, "Erro: Condição do ping deve ser booleana\n");
-                exit(1);
+            if (!value_is_bool(condition)) {
+                runtime_error(table, "Erro: Condição do ping deve ser booleana");
+            }
+            
+            if (table->context->profile != NULL) {
+                profile_count(table->context->profile, node, value_bool(condition) ? 0 : 1);
             }
             
-            if (condition.data.bool_val) {
+            if (value_bool(condition)) {
                 execute_statement(node->data.if_stmt.then_branch, table);
             } else if (node->data.if_stmt.else_branch != NULL) {
                 execute_statement(node->data.if_stmt.else_branch, table);
@@ -422,34 +1236,82 @@ static void execute_statement(Node* node, SymbolTable* table) {
             while (true) {
                 Value condition = evaluate_expression(node->data.while_stmt.condition, table);
                 
-                if (condition.type != VAL_BOOL) {
-                    fprintf(stderr, "Erro: Condição do stream deve ser booleana\n");
-                    exit(1);
+                if (!value_is_bool(condition)) {
+                    runtime_error(table, "Erro: Condição do stream deve ser booleana");
+                }
+                
+                if (table->context->profile != NULL) {
+                    profile_count(table->context->profile, node, value_bool(condition) ? 0 : 1);
                 }
                 
-                if (!condition.data.bool_val) {
+                if (!value_bool(condition)) {
                     break;
                 }
                 
+                charge_step(table);
+                checkpoint_tick(node, table);
                 execute_statement(node->data.while_stmt.body, table);
             }
             break;
         }
         
+        case NODE_PARALLEL_FOR: {
+            execute_parallel_for(node, table);
+            break;
+        }
+        
+        case NODE_SPAWN: {
+            execute_spawn(node, table);
+            break;
+        }
+        
+        case NODE_CHANNEL_DECL: {
+            declare_channel(node, table);
+            break;
+        }
+        
+        case NODE_SEND: {
+            ChannelBox* box = lookup_channel(table, node->data.channel_op.channel);
+            Value value = evaluate_expression(node->data.channel_op.value, table);
+            
+            if (!value_has_type(value, box->element_type)) {
+                runtime_error(table, "Erro: Tipo incompatível no envio para o canal '%s'", 
+                        node->data.channel_op.channel);
+            }
+            
+            TFChannelStatus status = tf_channel_send(box->channel, value);
+            if (status != TF_CHANNEL_OK) {
+                release_value(value);
+                channel_failure(table, status);
+            }
+            break;
+        }
+        
+        case NODE_CLOSE: {
+            ChannelBox* box = lookup_channel(table, node->data.channel_op.channel);
+            
+            if (tf_channel_close(box->channel) != TF_CHANNEL_OK) {
+                runtime_error(table, "Erro: Canal fechado mais de uma vez");
+            }
+            break;
+        }
+        
+        case NODE_RECEIVE_LOOP: {
+            execute_receive_loop(node, table);
+            break;
+        }
+        
         case NODE_REPEAT: {
             do {
-                execute_statement(node->data.repeat_stmt.body, table);
-                
-                Value condition = evaluate_expression(node->data.repeat_stmt.condition, table);
-                
-                if (condition.type != VAL_BOOL) {
-                    fprintf(stderr, "Erro: Condição do repeat-until deve ser booleana\n");
-                    exit(1);
-                }
+                int scope = enter_scope(table);
+                execute_statements(node->data.repeat_stmt.body, table);
                 
-                if (condition.data.bool_val) {
+                if (finish_repeat_iteration(node, table, scope)) {
                     break;
                 }
+                
+                charge_step(table);
+                checkpoint_tick(node, table);
             } while (true);
             break;
         }
@@ -463,27 +1325,32 @@ static void execute_statement(Node* node, SymbolTable* table) {
                 Value case_value = evaluate_expression(case_node->data.case_stmt.value, table);
                 
                 if (!check_same_type(condition, case_value)) {
-                    fprintf(stderr, "Erro: Tipo incompatível no select\n");
-                    exit(1);
+                    runtime_error(table, "Erro: Tipo incompatível no select");
                 }
                 
-                bool match = false;
-                
-                if (condition.type == VAL_INT && case_value.type == VAL_INT) {
-                    match = (condition.data.int_val == case_value.data.int_val);
-                } else if (condition.type == VAL_STRING && case_value.type == VAL_STRING) {
-                    match = (strcmp(condition.data.str_val, case_value.data.str_val) == 0);
-                } else if (condition.type == VAL_BOOL && case_value.type == VAL_BOOL) {
-                    match = (condition.data.bool_val == case_value.data.bool_val);
-                }
+                bool match = value_is_string(condition) ? strings_equal(condition, case_value)
+                                                        : condition == case_value;
+                release_value(case_value);
                 
                 if (match) {
+                    release_value(condition);
+                    if (table->context->profile != NULL) {
+                        profile_count(table->context->profile, node, i);
+                    }
                     execute_statement(case_node->data.case_stmt.body, table);
                     case_matched = true;
                     break;
                 }
             }
             
+            if (!case_matched) {
+                release_value(condition);
+            }
+            
+            if (!case_matched && table->context->profile != NULL) {
+                profile_count(table->context->profile, node, node->data.switch_stmt.case_count);
+            }
+            
             if (!case_matched && node->data.switch_stmt.default_case != NULL) {
                 execute_statement(node->data.switch_stmt.default_case, table);
             }
@@ -493,17 +1360,21 @@ static void execute_statement(Node* node, SymbolTable* table) {
         case NODE_PRINT: {
             Value value = evaluate_expression(node->data.print_stmt.expr, table);
             
-            switch (value.type) {
-                case VAL_INT:
-                    printf("%d\n", value.data.int_val);
-                    break;
-                case VAL_STRING:
-                    printf("%s\n", value.data.str_val);
-                    break;
-                case VAL_BOOL:
-                    printf("%s\n", value.data.bool_val ? "true" : "false");
-                    break;
+            if (table->context->output == stdout && value_is_int(value)) {
+                tf_log_i32(value_int(value));
+                break;
+            }
+            
+            char buffer[VALUE_TEXT_BUFFER];
+            size_t length;
+            const char* text = value_text(value, buffer, &length);
+            
+            if (table->context->output == stdout) {
+                tf_output_line(text, length);
+            } else {
+                fprintf(table->context->output, "%s\n", text);
             }
+            release_value(value);
             break;
         }
         
@@ -511,4 +1382,347 @@ static void execute_statement(Node* node, SymbolTable* table) {
             evaluate_expression(node, table);
             break;
     }
+}
+
+typedef struct {
+    Node* node;
+    SymbolTable* parent;
+    int* reduce_ops;
+    const char** reduce_types;
+    pthread_mutex_t error_lock;
+    volatile bool failed;
+    char error[256];
+} ParallelLoop;
+
+static int reduce_op_code(const char* op) {
+    if (strcmp(op, "+") == 0) return TF_REDUCE_ADD;
+    if (strcmp(op, "*") == 0) return TF_REDUCE_MUL;
+    if (strcmp(op, "AND") == 0) return TF_REDUCE_AND;
+    return TF_REDUCE_OR;
+}
+
+static Value reduce_value(const char* type, int raw) {
+    return strcmp(type, "bool") == 0 ? create_bool_value(raw != 0) : create_int_value(raw);
+}
+
+static int reduce_raw(Value value) {
+    return value_is_bool(value) ? value_bool(value) : value_int(value);
+}
+
+static void execute_parallel_chunk(void* env, int start, int end, int* partials) {
+    ParallelLoop* loop = (ParallelLoop*)env;
+    Node* node = loop->node;
+    
+    if (loop->failed) return;
+    
+    jmp_buf error_jump;
+    char error[256];
+    ExecutionContext context = *loop->parent->context;
+    context.error_jump = &error_jump;
+    context.error = error;
+    context.error_size = sizeof(error);
+    context.budget_slice = 0;
+    context.isolated_block = "stream parallel";
+    
+    TFMemAccount* previous_account = enter_budget_memory(&context);
+    SymbolTable* table = init_symbol_table();
+    table->parent = loop->parent;
+    table->context = &context;
+    
+    if (setjmp(error_jump) != 0) {
+        pthread_mutex_lock(&loop->error_lock);
+        if (!loop->failed) {
+            snprintf(loop->error, sizeof(loop->error), "%s", error);
+            loop->failed = true;
+        }
+        pthread_mutex_unlock(&loop->error_lock);
+        free_symbol_table(table);
+        tf_mem_account_leave(previous_account);
+        return;
+    }
+    
+    for (int r = 0; r < node->data.parallel_for.reduce_count; r++) {
+        set_symbol(table, node->data.parallel_for.reduce_vars[r], loop->reduce_types[r],
+                   reduce_value(loop->reduce_types[r], tf_parallel_identity(loop->reduce_ops[r])));
+    }
+    
+    for (int i = start; i < end && !loop->failed; i++) {
+        charge_step(table);
+        set_symbol(table, node->data.parallel_for.var_name, "i32", create_int_value(i));
+        execute_statement(node->data.parallel_for.body, table);
+    }
+    
+    for (int r = 0; r < node->data.parallel_for.reduce_count; r++) {
+        Symbol* symbol = get_local_symbol(table, node->data.parallel_for.reduce_vars[r]);
+        partials[r] = tf_parallel_combine(loop->reduce_ops[r], partials[r], reduce_raw(symbol->value));
+    }
+    
+    if (context.budget != NULL && context.budget_slice > 0) {
+        __atomic_fetch_sub(&context.budget->used_steps, context.budget_slice, __ATOMIC_RELAXED);
+    }
+    
+    free_symbol_table(table);
+    tf_mem_account_leave(previous_account);
+}
+
+static void execute_parallel_for(Node* node, SymbolTable* table) {
+    Value start = evaluate_expression(node->data.parallel_for.start, table);
+    Value end = evaluate_expression(node->data.parallel_for.end, table);
+    
+    if (!value_is_int(start) || !value_is_int(end)) {
+        runtime_error(table, "Erro: Limites do stream parallel devem ser i32");
+    }
+    
+    int reduce_count = node->data.parallel_for.reduce_count;
+    int reduce_ops[reduce_count > 0 ? reduce_count : 1];
+    int reduce_values[reduce_count > 0 ? reduce_count : 1];
+    const char* reduce_types[reduce_count > 0 ? reduce_count : 1];
+    Symbol* reduce_symbols[reduce_count > 0 ? reduce_count : 1];
+    
+    for (int r = 0; r < reduce_count; r++) {
+        Symbol* symbol = get_symbol(table, node->data.parallel_for.reduce_vars[r]);
+        
+        if (symbol == NULL) {
+            runtime_error(table, "Erro: Variável '%s' não definida", node->data.parallel_for.reduce_vars[r]);
+        }
+        
+        if (table->parent != NULL && get_local_symbol(table, symbol->name) == NULL) {
+            runtime_error(table, "Erro: Variável '%s' não pode ser modificada dentro de %s", 
+                    symbol->name, table->context->isolated_block);
+        }
+        
+        reduce_ops[r] = reduce_op_code(node->data.parallel_for.reduce_ops[r]);
+        
+        bool is_arithmetic = reduce_ops[r] == TF_REDUCE_ADD || reduce_ops[r] == TF_REDUCE_MUL;
+        if ((is_arithmetic && strcmp(symbol->type, "i32") != 0) ||
+            (!is_arithmetic && strcmp(symbol->type, "bool") != 0)) {
+            runtime_error(table, "Erro: Tipo incompatível na redução de '%s'", symbol->name);
+        }
+        
+        reduce_symbols[r] = symbol;
+        reduce_types[r] = symbol->type;
+        reduce_values[r] = reduce_raw(symbol->value);
+    }
+    
+    ParallelLoop loop;
+    loop.node = node;
+    loop.parent = table;
+    loop.reduce_ops = reduce_ops;
+    loop.reduce_types = reduce_types;
+    loop.failed = false;
+    pthread_mutex_init(&loop.error_lock, NULL);
+    
+    tf_parallel_for(value_int(start), value_int(end), execute_parallel_chunk, &loop,
+                    reduce_ops, reduce_values, reduce_count);
+    
+    pthread_mutex_destroy(&loop.error_lock);
+    
+    if (loop.failed) {
+        runtime_error(table, "%s", loop.error);
+    }
+    
+    for (int r = 0; r < reduce_count; r++) {
+        reduce_symbols[r]->value = reduce_value(reduce_types[r], reduce_values[r]);
+    }
+}
+
+typedef struct {
+    Node* body;
+    SymbolTable* captured;
+    ExecutionContext context;
+} SpawnedTask;
+
+static void capture_symbols(SymbolTable* table, SymbolTable* captured) {
+    if (table->parent != NULL) {
+        capture_symbols(table->parent, captured);
+    }
+    
+    if (captured->count + table->count > captured->capacity) {
+        captured->capacity = captured->count + table->count;
+        captured->symbols = (Symbol*)tf_realloc(captured->symbols, captured->capacity * sizeof(Symbol));
+    }
+    
+    for (int i = 0; i < table->count; i++) {
+        Symbol* symbol = &captured->symbols[captured->count++];
+        *symbol = table->symbols[i];
+        retain_value(symbol->value);
+    }
+}
+
+static void run_spawned_task(void* env) {
+    SpawnedTask* task = (SpawnedTask*)env;
+    jmp_buf error_jump;
+    char error[256];
+    
+    task->context.error_jump = &error_jump;
+    task->context.error = error;
+    task->context.error_size = sizeof(error);
+    task->context.budget_slice = 0;
+    
+    TFMemAccount* previous_account = enter_budget_memory(&task->context);
+    SymbolTable* table = init_symbol_table();
+    table->parent = task->captured;
+    table->context = &task->context;
+    task->captured->context = &task->context;
+    
+    if (setjmp(error_jump) == 0) {
+        execute_statement(task->body, table);
+    } else {
+        record_task_error(task->context.tasks, error);
+    }
+    
+    if (task->context.budget != NULL && task->context.budget_slice > 0) {
+        __atomic_fetch_sub(&task->context.budget->used_steps, task->context.budget_slice, __ATOMIC_RELAXED);
+    }
+    
+    free_symbol_table(table);
+    free_symbol_table(task->captured);
+    tf_free(task);
+    tf_mem_account_leave(previous_account);
+}
+
+static void execute_spawn(Node* node, SymbolTable* table) {
+    SpawnedTask* task = (SpawnedTask*)tf_malloc(sizeof(SpawnedTask));
+    task->body = node->data.spawn.body;
+    task->captured = init_symbol_table();
+    task->context = *table->context;
+    task->context.isolated_block = "spawn";
+    capture_symbols(table, task->captured);
+    
+    tf_task_spawn(task_group(table), run_spawned_task, task);
+}
+
+static void execute_receive_loop(Node* node, SymbolTable* table) {
+    ChannelBox* box = lookup_channel(table, node->data.receive_loop.channel);
+    
+    while (true) {
+        uint64_t value;
+        TFChannelStatus status = tf_channel_receive(box->channel, &value);
+        
+        if (status == TF_CHANNEL_CLOSED) break;
+        if (status != TF_CHANNEL_OK) {
+            channel_failure(table, status);
+        }
+        
+        charge_step(table);
+        
+        int scope = enter_scope(table);
+        set_symbol(table, node->data.receive_loop.var_name, box->element_type, value);
+        execute_statements(node->data.receive_loop.body, table);
+        leave_scope(table, scope);
+    }
+}
+
+static void restore_variables(SymbolTable* table, ResumeState* resume) {
+    Checkpoint* checkpoint = &resume->checkpoint;
+    
+    while (resume->next_variable < checkpoint->variable_count &&
+           checkpoint->variables[resume->next_variable].depth == (uint32_t)table->depth) {
+        CheckpointVariable* variable = &checkpoint->variables[resume->next_variable++];
+        
+        if (variable->type == CHECKPOINT_I32) {
+            set_symbol(table, variable->name, "i32", create_int_value(variable->int_value));
+        } else if (variable->type == CHECKPOINT_BOOL) {
+            set_symbol(table, variable->name, "bool", create_bool_value(variable->int_value != 0));
+        } else {
+            set_symbol(table, variable->name, "str",
+                       create_joined_string(variable->str_value, variable->str_length, "", 0));
+        }
+    }
+}
+
+static bool resume_reached(SymbolTable* table, ResumeState* resume) {
+    if (resume->position < resume->checkpoint.path_length) return false;
+    
+    if (resume->next_variable != resume->checkpoint.variable_count) {
+        runtime_error(table, "Erro: checkpoint inválido para este programa");
+    }
+    return true;
+}
+
+static uint32_t resume_index(SymbolTable* table, ResumeState* resume, uint32_t limit) {
+    if (resume->position >= resume->checkpoint.path_length ||
+        resume->checkpoint.path[resume->position] >= limit) {
+        runtime_error(table, "Erro: checkpoint inválido para este programa");
+    }
+    return resume->checkpoint.path[resume->position++];
+}
+
+static void resume_statements(Node* node, SymbolTable* table, ResumeState* resume) {
+    if (node == NULL || node->type != NODE_BLOCK) {
+        resume_statement(node, table, resume);
+        return;
+    }
+    
+    uint32_t index = resume_index(table, resume, (uint32_t)node->data.block.stmt_count);
+    resume_statement(node->data.block.statements[index], table, resume);
+    
+    for (int i = (int)index + 1; i < node->data.block.stmt_count; i++) {
+        execute_statement(node->data.block.statements[i], table);
+    }
+}
+
+static void resume_statement(Node* node, SymbolTable* table, ResumeState* resume) {
+    if (resume_reached(table, resume)) {
+        execute_statement(node, table);
+        return;
+    }
+    
+    if (node == NULL) {
+        runtime_error(table, "Erro: checkpoint inválido para este programa");
+    }
+    
+    switch (node->type) {
+        case NODE_BLOCK: {
+            int scope = enter_scope(table);
+            restore_variables(table, resume);
+            resume_statements(node, table, resume);
+            leave_scope(table, scope);
+            break;
+        }
+        
+        case NODE_IF: {
+            uint32_t index = resume_index(table, resume, 2);
+            resume_statement(index == 0 ? node->data.if_stmt.then_branch : node->data.if_stmt.else_branch,
+                             table, resume);
+            break;
+        }
+        
+        case NODE_WHILE: {
+            resume_index(table, resume, 1);
+            resume_statement(node->data.while_stmt.body, table, resume);
+            execute_statement(node, table);
+            break;
+        }
+        
+        case NODE_REPEAT: {
+            resume_index(table, resume, 1);
+            if (resume_reached(table, resume)) {
+                execute_statement(node, table);
+                break;
+            }
+            
+            int scope = enter_scope(table);
+            restore_variables(table, resume);
+            resume_statements(node->data.repeat_stmt.body, table, resume);
+            
+            if (!finish_repeat_iteration(node, table, scope)) {
+                charge_step(table);
+                checkpoint_tick(node, table);
+                execute_statement(node, table);
+            }
+            break;
+        }
+        
+        case NODE_SWITCH: {
+            int case_count = node->data.switch_stmt.case_count;
+            uint32_t index = resume_index(table, resume, (uint32_t)case_count + 1);
+            resume_statement((int)index < case_count ? node->data.switch_stmt.cases[index]->data.case_stmt.body
+                                                     : node->data.switch_stmt.default_case, table, resume);
+            break;
+        }
+        
+        default:
+            runtime_error(table, "Erro: checkpoint inválido para este programa");
+    }
 }
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef INTERPRETER_H
+#define INTERPRETER_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include "llvm_generator.h"
+#include "profile.h"
+
+typedef struct {
+    Profile* profile;
+    ExecutionLimits limits;
+    const char* checkpoint_file;
+    uint64_t checkpoint_every;
+    bool resume;
+} InterpreterOptions;
+
+typedef struct {
+    char* name;
+    char* type;
+    int int_value;
+    char* str_value;
+} PrecomputedVariable;
+
+typedef struct {
+    int statement_count;
+    char* output;
+    size_t output_size;
+    PrecomputedVariable* variables;
+    int variable_count;
+} PrecomputedPrefix;
+
+int interpret_program(Node* root, FILE* input, FILE* output, const InterpreterOptions* options,
+                      char* error, size_t error_size);
+void execute_ast(Node* root, const InterpreterOptions* options);
+int precompute_prefix(Node* body, const ExecutionLimits* limits, PrecomputedPrefix* prefix);
+void free_precomputed_prefix(PrecomputedPrefix* prefix);
+
+#endif
@@ -0,0 +1,71 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dlfcn.h>
+#include <limits.h>
+#include <unistd.h>
+#include "llvm_backend.h"
+
+static LLVMBackend backend;
+static void* backend_handle = NULL;
+
+static void* open_backend(const char* path, char* error, size_t error_size) {
+    void* handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    
+    if (handle == NULL) {
+        snprintf(error, error_size, "Erro: não foi possível carregar o backend LLVM: %s", dlerror());
+    }
+    return handle;
+}
+
+static void* find_backend(char* error, size_t error_size) {
+    const char* override = getenv("TECHFLOW_BACKEND");
+    if (override != NULL && override[0] != '\0') {
+        return open_backend(override, error, error_size);
+    }
+    
+    char executable[PATH_MAX];
+    ssize_t length = readlink("/proc/self/exe", executable, sizeof(executable) - 1);
+    if (length > 0) {
+        executable[length] = '\0';
+        char* slash = strrchr(executable, '/');
+        if (slash != NULL) {
+            *slash = '\0';
+            
+            const char* candidates[] = { "../lib/" LLVM_BACKEND_NAME, LLVM_BACKEND_NAME };
+            for (size_t i = 0; i < sizeof(candidates) / sizeof(candidates[0]); i++) {
+                char path[PATH_MAX + 32];
+                snprintf(path, sizeof(path), "%s/%s", executable, candidates[i]);
+                if (access(path, R_OK) == 0) {
+                    return open_backend(path, error, error_size);
+                }
+            }
+        }
+    }
+    
+    return open_backend(LLVM_BACKEND_NAME, error, error_size);
+}
+
+const LLVMBackend* load_llvm_backend(char* error, size_t error_size) {
+    if (backend_handle != NULL) return &backend;
+    
+    void* handle = find_backend(error, error_size);
+    if (handle == NULL) return NULL;
+    
+    backend.warm_target_machine = (void (*)(const CodegenOptions*))dlsym(handle, "warm_target_machine");
+    backend.generate_llvm_code = (int (*)(Node*, const char*, const CodegenOptions*))dlsym(handle, "generate_llvm_code");
+    backend.create_repl_session = (ReplSession* (*)(char*, size_t))dlsym(handle, "create_repl_session");
+    backend.execute_repl_statements = (int (*)(ReplSession*, Node*))dlsym(handle, "execute_repl_statements");
+    backend.free_repl_session = (void (*)(ReplSession*))dlsym(handle, "free_repl_session");
+    
+    if (backend.warm_target_machine == NULL || backend.generate_llvm_code == NULL ||
+        backend.create_repl_session == NULL || backend.execute_repl_statements == NULL ||
+        backend.free_repl_session == NULL) {
+        snprintf(error, error_size, "Erro: backend LLVM incompatível (símbolos ausentes)");
+        dlclose(handle);
+        return NULL;
+    }
+    
+    backend_handle = handle;
+    return &backend;
+}
@@ -0,0 +1,19 @@
+#ifndef LLVM_BACKEND_H
+#define LLVM_BACKEND_H
+
+#include <stddef.h>
+#include "llvm_generator.h"
+
+#define LLVM_BACKEND_NAME "techflow_llvm.so"
+
+typedef struct {
+    void (*warm_target_machine)(const CodegenOptions* options);
+    int (*generate_llvm_code)(Node* ast_root, const char* output_file, const CodegenOptions* options);
+    ReplSession* (*create_repl_session)(char* error, size_t error_size);
+    int (*execute_repl_statements)(ReplSession* session, Node* statements);
+    void (*free_repl_session)(ReplSession* session);
+} LLVMBackend;
+
+const LLVMBackend* load_llvm_backend(char* error, size_t error_size);
+
+#endif
@@ -2,49 +2,124 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <setjmp.h>
 #include <llvm-c/Core.h>
 #include <llvm-c/Analysis.h>
 #include <llvm-c/ExecutionEngine.h>
 #include <llvm-c/Target.h>
+#include <llvm-c/TargetMachine.h>
 #include <llvm-c/Transforms/Scalar.h>
+#include <llvm-c/Transforms/Utils.h>
 #include <llvm-c/BitWriter.h>
+#include <llvm-c/DebugInfo.h>
+#include <llvm-c/Support.h>
+#include <unistd.h>
+#include <sys/mman.h>
 #include "llvm_generator.h"
+#include "runtime_support.h"
+#include "profile.h"
+#include "interpreter.h"
+
+#define PARTIAL_EVAL_MAX_MS 1000
+#define PARTIAL_EVAL_MAX_MEM (64ull << 20)
 
 typedef struct {
     char* name;
     LLVMValueRef value;
     LLVMTypeRef type;
+    bool read_only;
+    bool slot;
 } Symbol;
 
 typedef struct {
     Symbol* symbols;
     int symbol_count;
     int capacity;
+    int scope_start;
 } SymbolTable;
 
+typedef struct {
+    LLVMValueRef* allocas;
+    int count;
+    int capacity;
+} StackSlots;
+
+typedef struct {
+    const char* kind;
+    int line;
+    LLVMValueRef counter;
+} InstrumentedLoop;
+
+typedef struct {
+    InstrumentedLoop* loops;
+    int count;
+    int capacity;
+} InstrumentTable;
+
 typedef struct {
     LLVMModuleRef module;
     LLVMBuilderRef builder;
     LLVMValueRef function;
     SymbolTable* symbol_table;
+    LLVMDIBuilderRef di_builder;
+    LLVMMetadataRef di_file;
+    LLVMMetadataRef di_scope;
+    const Profile* profile;
+    bool budget;
+    InstrumentTable* instrument;
+    bool parallel;
+    const char* isolated_block;
+    bool minimal_runtime;
+    LLVMBuilderRef alloca_builder;
+    StackSlots* free_slots;
 } GeneratorContext;
 
+static jmp_buf* codegen_recovery = NULL;
+
+static void codegen_error(const char* format, ...) __attribute__((noreturn, format(printf, 1, 2)));
+
+static void codegen_error(const char* format, ...) {
+    va_list args;
+    
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+    fputc('\n', stderr);
+    
+    if (codegen_recovery != NULL) {
+        longjmp(*codegen_recovery, 1);
+    }
+    exit(1);
+}
+
 static SymbolTable* create_symbol_table();
-static void add_symbol(SymbolTable* table, const char* name, LLVMValueRef value, LLVMTypeRef type);
+static Symbol* add_symbol(SymbolTable* table, const char* name, LLVMValueRef value, LLVMTypeRef type);
 static Symbol* find_symbol(SymbolTable* table, const char* name);
 static void free_symbol_table(SymbolTable* table);
 
 static LLVMValueRef generate_node(Node* node, GeneratorContext* context);
 static LLVMValueRef generate_block(Node* node, GeneratorContext* context);
+static LLVMValueRef generate_statements(Node* node, GeneratorContext* context);
 static LLVMValueRef generate_var_decl(Node* node, GeneratorContext* context);
 static LLVMValueRef generate_assignment(Node* node, GeneratorContext* context);
 static LLVMValueRef generate_if_stmt(Node* node, GeneratorContext* context);
 static LLVMValueRef generate_while_stmt(Node* node, GeneratorContext* context);
 static LLVMValueRef generate_repeat_stmt(Node* node, GeneratorContext* context);
+static LLVMValueRef generate_parallel_for(Node* node, GeneratorContext* context);
+static LLVMValueRef generate_spawn(Node* node, GeneratorContext* context);
+static LLVMValueRef generate_channel_decl(Node* node, GeneratorContext* context);
+static LLVMValueRef generate_send(Node* node, GeneratorContext* context);
+static LLVMValueRef generate_receive(Node* node, GeneratorContext* context);
+static LLVMValueRef generate_close(Node* node, GeneratorContext* context);
+static LLVMValueRef generate_receive_loop(Node* node, GeneratorContext* context);
 static LLVMValueRef generate_switch_stmt(Node* node, GeneratorContext* context);
 static LLVMValueRef generate_print_stmt(Node* node, GeneratorContext* context);
 static LLVMValueRef generate_binary_op(Node* node, GeneratorContext* context);
+static LLVMValueRef generate_logical_op(Node* node, GeneratorContext* context);
 static LLVMValueRef generate_unary_op(Node* node, GeneratorContext* context);
+static LLVMValueRef generate_read_expr(Node* node, GeneratorContext* context);
 static LLVMValueRef generate_expression(Node* node, GeneratorContext* context);
 
 static LLVMValueRef int_to_string(GeneratorContext* context, LLVMValueRef int_val) {
@@ -61,43 +136,254 @@ static LLVMValueRef int_to_string(GeneratorContext* context, LLVMValueRef int_va
     return LLVMBuildCall2(context->builder, func_type, int_to_str_func, args, 1, "int_str");
 }
 
+static LLVMValueRef build_string_constant(GeneratorContext* context, const char* text, const char* name) {
+    size_t length = strlen(text);
+    LLVMValueRef fields[] = {
+        LLVMConstInt(LLVMInt64Type(), length, false),
+        LLVMConstString(text, (unsigned)length, false)
+    };
+    LLVMValueRef initializer = LLVMConstStruct(fields, 2, false);
+    LLVMTypeRef string_type = LLVMTypeOf(initializer);
+    
+    LLVMValueRef global = LLVMAddGlobal(context->module, string_type, name);
+    LLVMSetInitializer(global, initializer);
+    LLVMSetGlobalConstant(global, true);
+    LLVMSetLinkage(global, LLVMPrivateLinkage);
+    LLVMSetUnnamedAddress(global, LLVMGlobalUnnamedAddr);
+    
+    LLVMValueRef indices[] = {
+        LLVMConstInt(LLVMInt32Type(), 0, false),
+        LLVMConstInt(LLVMInt32Type(), 1, false),
+        LLVMConstInt(LLVMInt32Type(), 0, false)
+    };
+    return LLVMConstInBoundsGEP2(string_type, global, indices, 3);
+}
+
+static LLVMValueRef get_runtime_function(GeneratorContext* context, const char* name, LLVMTypeRef ret_type,
+                                         LLVMTypeRef* param_types, unsigned param_count) {
+    LLVMValueRef func = LLVMGetNamedFunction(context->module, name);
+    if (!func) {
+        LLVMTypeRef func_type = LLVMFunctionType(ret_type, param_types, param_count, 0);
+        func = LLVMAddFunction(context->module, name, func_type);
+    }
+    return func;
+}
+
+static void require_full_runtime(GeneratorContext* context, const char* construct) {
+    if (context->minimal_runtime) {
+        codegen_error("Erro: %s não está disponível com --runtime=minimal", construct);
+    }
+}
+
+static void build_back_edge(GeneratorContext* context, LLVMBasicBlockRef target) {
+    if (!context->budget) {
+        LLVMBuildBr(context->builder, target);
+        return;
+    }
+    
+    LLVMValueRef counter = LLVMGetNamedGlobal(context->module, "tf_budget_counter");
+    LLVMValueRef current = LLVMBuildLoad2(context->builder, LLVMInt64Type(), counter, "budget");
+    LLVMValueRef remaining = LLVMBuildSub(context->builder, current,
+                                          LLVMConstInt(LLVMInt64Type(), 1, false), "budget_left");
+    LLVMBuildStore(context->builder, remaining, counter);
+    
+    LLVMValueRef exhausted = LLVMBuildICmp(context->builder, LLVMIntSLT, remaining,
+                                           LLVMConstInt(LLVMInt64Type(), 0, false), "budget_exhausted");
+    LLVMBasicBlockRef tick_block = LLVMAppendBasicBlock(context->function, "budget_tick");
+    LLVMValueRef branch = LLVMBuildCondBr(context->builder, exhausted, tick_block, target);
+    
+    LLVMValueRef weights[] = {
+        LLVMMDString("branch_weights", 14),
+        LLVMConstInt(LLVMInt32Type(), 1, false),
+        LLVMConstInt(LLVMInt32Type(), 1023, false)
+    };
+    LLVMSetMetadata(branch, LLVMGetMDKindID("prof", 4), LLVMMDNode(weights, 3));
+    
+    LLVMPositionBuilderAtEnd(context->builder, tick_block);
+    LLVMValueRef tick_func = get_runtime_function(context, "tf_budget_tick", LLVMVoidType(), NULL, 0);
+    LLVMBuildCall2(context->builder, LLVMGetElementType(LLVMTypeOf(tick_func)), tick_func, NULL, 0, "");
+    LLVMBuildBr(context->builder, target);
+}
+
+static LLVMValueRef create_loop_counter(GeneratorContext* context, Node* node, const char* kind) {
+    InstrumentTable* table = context->instrument;
+    
+    if (table == NULL) return NULL;
+    
+    if (table->count == table->capacity) {
+        table->capacity = table->capacity == 0 ? 16 : table->capacity * 2;
+        table->loops = (InstrumentedLoop*)realloc(table->loops, table->capacity * sizeof(InstrumentedLoop));
+    }
+    
+    LLVMValueRef counter = LLVMAddGlobal(context->module, LLVMInt64Type(), "tf_loop_counter");
+    LLVMSetInitializer(counter, LLVMConstInt(LLVMInt64Type(), 0, false));
+    LLVMSetLinkage(counter, LLVMInternalLinkage);
+    LLVMSetAlignment(counter, 8);
+    
+    table->loops[table->count].kind = kind;
+    table->loops[table->count].line = node->line;
+    table->loops[table->count].counter = counter;
+    table->count++;
+    return counter;
+}
+
+static void count_loop_iterations(GeneratorContext* context, LLVMValueRef counter, LLVMValueRef amount) {
+    if (counter == NULL) return;
+    
+    if (context->parallel) {
+        LLVMBuildAtomicRMW(context->builder, LLVMAtomicRMWBinOpAdd, counter, amount,
+                           LLVMAtomicOrderingMonotonic, false);
+        return;
+    }
+    
+    LLVMValueRef current = LLVMBuildLoad2(context->builder, LLVMInt64Type(), counter, "loop_count");
+    LLVMValueRef next = LLVMBuildAdd(context->builder, current, amount, "loop_count_next");
+    LLVMBuildStore(context->builder, next, counter);
+}
+
+static void register_instrumentation(GeneratorContext* context, LLVMBasicBlockRef entry, const char* source_file) {
+    InstrumentTable* table = context->instrument;
+    LLVMTypeRef i8_ptr = LLVMPointerType(LLVMInt8Type(), 0);
+    LLVMTypeRef i64_ptr = LLVMPointerType(LLVMInt64Type(), 0);
+    LLVMTypeRef fields[] = { i8_ptr, LLVMInt32Type(), i64_ptr };
+    LLVMTypeRef loop_type = LLVMStructType(fields, 3, false);
+    
+    LLVMValueRef first = LLVMGetFirstInstruction(entry);
+    if (first != NULL) {
+        LLVMPositionBuilderBefore(context->builder, first);
+    } else {
+        LLVMPositionBuilderAtEnd(context->builder, entry);
+    }
+    
+    LLVMValueRef entries[table->count > 0 ? table->count : 1];
+    for (int i = 0; i < table->count; i++) {
+        LLVMValueRef kind = LLVMBuildGlobalStringPtr(context->builder, table->loops[i].kind, "loop_kind");
+        LLVMValueRef values[] = {
+            kind,
+            LLVMConstInt(LLVMInt32Type(), table->loops[i].line, false),
+            table->loops[i].counter
+        };
+        entries[i] = LLVMConstNamedStruct(loop_type, values, 3);
+    }
+    
+    LLVMTypeRef array_type = LLVMArrayType(loop_type, table->count);
+    LLVMValueRef loops = LLVMAddGlobal(context->module, array_type, "tf_instrument_loops");
+    LLVMSetInitializer(loops, LLVMConstArray(loop_type, entries, table->count));
+    LLVMSetGlobalConstant(loops, true);
+    LLVMSetLinkage(loops, LLVMPrivateLinkage);
+    
+    LLVMValueRef program = LLVMBuildGlobalStringPtr(context->builder, source_file != NULL ? source_file : "",
+                                                    "program_name");
+    LLVMTypeRef param_types[] = { i8_ptr, LLVMPointerType(loop_type, 0), LLVMInt32Type() };
+    LLVMValueRef register_func = get_runtime_function(context, "tf_instrument_register", LLVMVoidType(),
+                                                      param_types, 3);
+    LLVMValueRef args[] = {
+        program,
+        LLVMConstBitCast(loops, LLVMPointerType(loop_type, 0)),
+        LLVMConstInt(LLVMInt32Type(), table->count, false)
+    };
+    LLVMBuildCall2(context->builder, LLVMGetElementType(LLVMTypeOf(register_func)), register_func, args, 3, "");
+}
+
+static LLVMValueRef build_string_comparison(GeneratorContext* context, const char* op,
+                                            LLVMValueRef left, LLVMValueRef right) {
+    LLVMTypeRef param_types[] = {
+        LLVMPointerType(LLVMInt8Type(), 0),
+        LLVMPointerType(LLVMInt8Type(), 0)
+    };
+    LLVMValueRef args[] = { left, right };
+    
+    if (strcmp(op, "EQ") == 0 || strcmp(op, "NEQ") == 0) {
+        LLVMValueRef equals_func = get_runtime_function(context, "tf_string_equals", LLVMInt32Type(), param_types, 2);
+        LLVMTypeRef func_type = LLVMGetElementType(LLVMTypeOf(equals_func));
+        LLVMValueRef result = LLVMBuildCall2(context->builder, func_type, equals_func, args, 2, "str_eq");
+        return LLVMBuildICmp(context->builder, strcmp(op, "EQ") == 0 ? LLVMIntNE : LLVMIntEQ,
+                             result, LLVMConstInt(LLVMInt32Type(), 0, false), "str_eqtmp");
+    }
+    
+    LLVMIntPredicate predicate;
+    if (strcmp(op, "<") == 0) {
+        predicate = LLVMIntSLT;
+    } else if (strcmp(op, ">") == 0) {
+        predicate = LLVMIntSGT;
+    } else if (strcmp(op, "LE") == 0) {
+        predicate = LLVMIntSLE;
+    } else {
+        predicate = LLVMIntSGE;
+    }
+    
+    LLVMValueRef compare_func = get_runtime_function(context, "tf_string_compare", LLVMInt32Type(), param_types, 2);
+    LLVMTypeRef func_type = LLVMGetElementType(LLVMTypeOf(compare_func));
+    LLVMValueRef result = LLVMBuildCall2(context->builder, func_type, compare_func, args, 2, "str_cmp");
+    return LLVMBuildICmp(context->builder, predicate, result, LLVMConstInt(LLVMInt32Type(), 0, false), "str_cmptmp");
+}
+
+static LLVMValueRef bool_to_string(GeneratorContext* context, LLVMValueRef bool_val) {
+    LLVMTypeRef param_types[] = { LLVMInt1Type() };
+    LLVMValueRef bool_to_str_func = get_runtime_function(context, "bool_to_string",
+                                                         LLVMPointerType(LLVMInt8Type(), 0), param_types, 1);
+    
+    LLVMTypeRef func_type = LLVMGetElementType(LLVMTypeOf(bool_to_str_func));
+    LLVMValueRef args[] = { bool_val };
+    return LLVMBuildCall2(context->builder, func_type, bool_to_str_func, args, 1, "bool_str");
+}
+
 static SymbolTable* create_symbol_table() {
     SymbolTable* table = (SymbolTable*)malloc(sizeof(SymbolTable));
     table->symbols = NULL;
     table->symbol_count = 0;
     table->capacity = 0;
+    table->scope_start = 0;
     return table;
 }
 
-static void add_symbol(SymbolTable* table, const char* name, LLVMValueRef value, LLVMTypeRef type) {
-    for (int i = 0; i < table->symbol_count; i++) {
-        if (strcmp(table->symbols[i].name, name) == 0) {
-            table->symbols[i].value = value;
-            return;
-        }
-    }
-    
+static Symbol* push_symbol(SymbolTable* table, const char* name, LLVMValueRef value, LLVMTypeRef type) {
     if (table->symbol_count >= table->capacity) {
         int new_capacity = table->capacity == 0 ? 8 : table->capacity * 2;
         Symbol* new_symbols = (Symbol*)realloc(table->symbols, new_capacity * sizeof(Symbol));
         
         if (new_symbols == NULL) {
-            fprintf(stderr, "Erro: Falha na alocação de memória para tabela de símbolos\n");
-            exit(1);
+            codegen_error("Erro: Falha na alocação de memória para tabela de símbolos");
         }
         
         table->symbols = new_symbols;
         table->capacity = new_capacity;
     }
     
-    table->symbols[table->symbol_count].name = strdup(name);
-    table->symbols[table->symbol_count].value = value;
-    table->symbols[table->symbol_count].type = type;
-    table->symbol_count++;
+    Symbol* symbol = &table->symbols[table->symbol_count++];
+    symbol->name = strdup(name);
+    symbol->value = value;
+    symbol->type = type;
+    symbol->read_only = false;
+    symbol->slot = false;
+    return symbol;
+}
+
+static Symbol* find_local_symbol(SymbolTable* table, const char* name) {
+    for (int i = table->symbol_count - 1; i >= table->scope_start; i--) {
+        if (strcmp(table->symbols[i].name, name) == 0) {
+            return &table->symbols[i];
+        }
+    }
+    return NULL;
+}
+
+static Symbol* add_symbol(SymbolTable* table, const char* name, LLVMValueRef value, LLVMTypeRef type) {
+    Symbol* symbol = find_local_symbol(table, name);
+    
+    if (symbol == NULL) {
+        return push_symbol(table, name, value, type);
+    }
+    
+    symbol->value = value;
+    symbol->type = type;
+    symbol->read_only = false;
+    symbol->slot = false;
+    return symbol;
 }
 
 static Symbol* find_symbol(SymbolTable* table, const char* name) {
-    for (int i = 0; i < table->symbol_count; i++) {
+    for (int i = table->symbol_count - 1; i >= 0; i--) {
         if (strcmp(table->symbols[i].name, name) == 0) {
             return &table->symbols[i];
         }
@@ -116,19 +402,418 @@ static void free_symbol_table(SymbolTable* table) {
     free(table);
 }
 
-void generate_llvm_code(Node* ast_root, const char* output_file) {
+static LLVMValueRef build_entry_alloca(GeneratorContext* context, LLVMTypeRef type, LLVMValueRef count,
+                                       const char* name) {
+    LLVMBasicBlockRef entry = LLVMGetEntryBasicBlock(context->function);
+    LLVMValueRef first = LLVMGetFirstInstruction(entry);
+    
+    if (first != NULL) {
+        LLVMPositionBuilderBefore(context->alloca_builder, first);
+    } else {
+        LLVMPositionBuilderAtEnd(context->alloca_builder, entry);
+    }
+    
+    return count != NULL ? LLVMBuildArrayAlloca(context->alloca_builder, type, count, name)
+                         : LLVMBuildAlloca(context->alloca_builder, type, name);
+}
+
+static void build_lifetime_marker(GeneratorContext* context, const char* intrinsic, Symbol* symbol) {
+    LLVMTypeRef i8_ptr = LLVMPointerType(LLVMInt8Type(), 0);
+    unsigned id = LLVMLookupIntrinsicID(intrinsic, strlen(intrinsic));
+    LLVMValueRef func = LLVMGetIntrinsicDeclaration(context->module, id, &i8_ptr, 1);
+    unsigned long long size = LLVMABISizeOfType(LLVMGetModuleDataLayout(context->module), symbol->type);
+    
+    LLVMValueRef args[] = {
+        LLVMConstInt(LLVMInt64Type(), size, false),
+        LLVMBuildBitCast(context->builder, symbol->value, i8_ptr, "")
+    };
+    LLVMBuildCall2(context->builder, LLVMIntrinsicGetType(LLVMGetGlobalContext(), id, &i8_ptr, 1), func, args, 2, "");
+}
+
+static LLVMValueRef acquire_stack_slot(GeneratorContext* context, LLVMTypeRef type, const char* name) {
+    StackSlots* slots = context->free_slots;
+    
+    for (int i = slots->count - 1; i >= 0; i--) {
+        if (LLVMGetAllocatedType(slots->allocas[i]) == type) {
+            LLVMValueRef alloca = slots->allocas[i];
+            slots->allocas[i] = slots->allocas[--slots->count];
+            return alloca;
+        }
+    }
+    
+    return build_entry_alloca(context, type, NULL, name);
+}
+
+static void release_stack_slot(GeneratorContext* context, Symbol* symbol) {
+    StackSlots* slots = context->free_slots;
+    
+    build_lifetime_marker(context, "llvm.lifetime.end", symbol);
+    
+    if (slots->count >= slots->capacity) {
+        slots->capacity = slots->capacity == 0 ? 8 : slots->capacity * 2;
+        slots->allocas = (LLVMValueRef*)realloc(slots->allocas, slots->capacity * sizeof(LLVMValueRef));
+        if (slots->allocas == NULL) {
+            codegen_error("Erro: Falha na alocação de memória para a pilha de variáveis");
+        }
+    }
+    slots->allocas[slots->count++] = symbol->value;
+}
+
+static int enter_scope(GeneratorContext* context) {
+    SymbolTable* table = context->symbol_table;
+    int saved = table->scope_start;
+    table->scope_start = table->symbol_count;
+    return saved;
+}
+
+static void leave_scope(GeneratorContext* context, int saved) {
+    SymbolTable* table = context->symbol_table;
+    
+    for (int i = table->symbol_count - 1; i >= table->scope_start; i--) {
+        if (table->symbols[i].slot) {
+            release_stack_slot(context, &table->symbols[i]);
+        }
+        free(table->symbols[i].name);
+    }
+    
+    table->symbol_count = table->scope_start;
+    table->scope_start = saved;
+}
+
+static void set_branch_weights(GeneratorContext* context, LLVMValueRef branch, const Node* node,
+                               const int* arms, int arm_count) {
+    if (context->profile == NULL) return;
+    
+    const ProfileEntry* entry = find_profile_entry(context->profile, node);
+    if (entry == NULL) return;
+    
+    uint64_t max_count = 0;
+    for (int i = 0; i < arm_count; i++) {
+        if (entry->counts[arms[i]] > max_count) max_count = entry->counts[arms[i]];
+    }
+    
+    int shift = 0;
+    while ((max_count >> shift) >= UINT32_MAX) {
+        shift++;
+    }
+    
+    LLVMValueRef operands[arm_count + 1];
+    operands[0] = LLVMMDString("branch_weights", 14);
+    for (int i = 0; i < arm_count; i++) {
+        uint64_t weight = (entry->counts[arms[i]] >> shift) + 1;
+        operands[i + 1] = LLVMConstInt(LLVMInt32Type(), weight, false);
+    }
+    
+    LLVMSetMetadata(branch, LLVMGetMDKindID("prof", 4), LLVMMDNode(operands, arm_count + 1));
+}
+
+static LLVMMetadataRef create_debug_function(GeneratorContext* context, LLVMValueRef function,
+                                             const char* name, int line) {
+    LLVMMetadataRef subroutine_type = LLVMDIBuilderCreateSubroutineType(context->di_builder, context->di_file,
+                                                                        NULL, 0, LLVMDIFlagZero);
+    LLVMMetadataRef subprogram = LLVMDIBuilderCreateFunction(context->di_builder, context->di_file,
+                                                             name, strlen(name), name, strlen(name),
+                                                             context->di_file, line, subroutine_type,
+                                                             LLVMGetLinkage(function) == LLVMInternalLinkage,
+                                                             true, line, LLVMDIFlagZero, false);
+    LLVMSetSubprogram(function, subprogram);
+    return subprogram;
+}
+
+static void set_debug_location(GeneratorContext* context, int line) {
+    if (context->di_builder == NULL || line <= 0) return;
+    
+    LLVMMetadataRef location = LLVMDIBuilderCreateDebugLocation(LLVMGetGlobalContext(), line, 0,
+                                                                context->di_scope, NULL);
+    LLVMSetCurrentDebugLocation2(context->builder, location);
+}
+
+static void create_debug_info(GeneratorContext* context, const char* source_file) {
+    char directory[4096];
+    const char* producer = "TechFlow";
+    
+    if (getcwd(directory, sizeof(directory)) == NULL) {
+        strcpy(directory, ".");
+    }
+    
+    context->di_builder = LLVMCreateDIBuilder(context->module);
+    context->di_file = LLVMDIBuilderCreateFile(context->di_builder, source_file, strlen(source_file),
+                                               directory, strlen(directory));
+    LLVMDIBuilderCreateCompileUnit(context->di_builder, LLVMDWARFSourceLanguageC, context->di_file,
+                                   producer, strlen(producer), false, "", 0, 0, "", 0,
+                                   LLVMDWARFEmissionFull, 0, false, false, "", 0, "", 0);
+    
+    LLVMAddModuleFlag(context->module, LLVMModuleFlagBehaviorWarning, "Debug Info Version", 18,
+                      LLVMValueAsMetadata(LLVMConstInt(LLVMInt32Type(), LLVMDebugMetadataVersion(), false)));
+    LLVMAddModuleFlag(context->module, LLVMModuleFlagBehaviorWarning, "Dwarf Version", 13,
+                      LLVMValueAsMetadata(LLVMConstInt(LLVMInt32Type(), 4, false)));
+}
+
+void initialize_llvm_backend(void) {
+    static bool initialized = false;
+    
+    if (initialized) return;
+    
     LLVMInitializeCore(LLVMGetGlobalPassRegistry());
     LLVMInitializeNativeTarget();
     LLVMInitializeNativeAsmPrinter();
+    initialized = true;
+}
+
+static struct {
+    char* triple;
+    char* cpu;
+    char* features;
+    LLVMTargetMachineRef machine;
+} target_cache;
+
+static void initialize_all_targets(void) {
+    static bool initialized = false;
+    
+    if (initialized) return;
+    
+    LLVMInitializeAllTargetInfos();
+    LLVMInitializeAllTargets();
+    LLVMInitializeAllTargetMCs();
+    LLVMInitializeAllAsmPrinters();
+    initialized = true;
+}
+
+static char* join_features(const char* first, const char* second) {
+    size_t first_length = strlen(first);
+    size_t second_length = strlen(second);
+    char* result = (char*)malloc(first_length + second_length + 2);
+    
+    memcpy(result, first, first_length);
+    result[first_length] = first_length > 0 && second_length > 0 ? ',' : '\0';
+    memcpy(result + first_length + (first_length > 0 && second_length > 0), second, second_length + 1);
+    return result;
+}
+
+static LLVMTargetMachineRef get_target_machine(const CodegenOptions* options, char* error, size_t error_size) {
+    char* default_triple = LLVMGetDefaultTargetTriple();
+    char* triple = options->target_triple != NULL ? LLVMNormalizeTargetTriple(options->target_triple)
+                                                  : LLVMCreateMessage(default_triple);
+    bool native = options->cpu != NULL && strcmp(options->cpu, "native") == 0;
+    char* cpu;
+    char* features;
+    
+    if (native && strcmp(triple, default_triple) != 0) {
+        snprintf(error, error_size, "Erro: --mcpu=native só pode ser usado com o alvo do host (%s)", default_triple);
+        LLVMDisposeMessage(default_triple);
+        LLVMDisposeMessage(triple);
+        return NULL;
+    }
+    LLVMDisposeMessage(default_triple);
+    
+    if (native) {
+        char* host_cpu = LLVMGetHostCPUName();
+        char* host_features = LLVMGetHostCPUFeatures();
+        cpu = strdup(host_cpu);
+        features = join_features(host_features, options->features != NULL ? options->features : "");
+        LLVMDisposeMessage(host_cpu);
+        LLVMDisposeMessage(host_features);
+    } else {
+        cpu = strdup(options->cpu != NULL ? options->cpu : "generic");
+        features = strdup(options->features != NULL ? options->features : "");
+    }
+    
+    if (target_cache.machine != NULL && strcmp(target_cache.triple, triple) == 0 &&
+        strcmp(target_cache.cpu, cpu) == 0 && strcmp(target_cache.features, features) == 0) {
+        LLVMDisposeMessage(triple);
+        free(cpu);
+        free(features);
+        return target_cache.machine;
+    }
+    
+    LLVMTargetRef target;
+    char* message = NULL;
+    if (LLVMGetTargetFromTriple(triple, &target, &message) != 0) {
+        LLVMDisposeMessage(message);
+        message = NULL;
+        initialize_all_targets();
+        
+        if (LLVMGetTargetFromTriple(triple, &target, &message) != 0) {
+            snprintf(error, error_size, "Erro: alvo '%s' não suportado: %s", triple, message);
+            LLVMDisposeMessage(message);
+            LLVMDisposeMessage(triple);
+            free(cpu);
+            free(features);
+            return NULL;
+        }
+    }
+    
+    LLVMTargetMachineRef machine = LLVMCreateTargetMachine(target, triple, cpu, features,
+                                                           LLVMCodeGenLevelAggressive, LLVMRelocPIC,
+                                                           LLVMCodeModelDefault);
+    if (machine == NULL) {
+        snprintf(error, error_size, "Erro: não foi possível criar a máquina alvo para '%s' (cpu '%s')", triple, cpu);
+        LLVMDisposeMessage(triple);
+        free(cpu);
+        free(features);
+        return NULL;
+    }
+    
+    if (target_cache.machine != NULL) {
+        LLVMDisposeTargetMachine(target_cache.machine);
+        LLVMDisposeMessage(target_cache.triple);
+        free(target_cache.cpu);
+        free(target_cache.features);
+    }
+    target_cache.triple = triple;
+    target_cache.cpu = cpu;
+    target_cache.features = features;
+    target_cache.machine = machine;
+    return machine;
+}
+
+void warm_target_machine(const CodegenOptions* options) {
+    char error[256];
+    
+    initialize_llvm_backend();
+    get_target_machine(options, error, sizeof(error));
+}
+
+static void set_target_attributes(LLVMModuleRef module) {
+    LLVMContextRef llvm_context = LLVMGetModuleContext(module);
+    
+    for (LLVMValueRef function = LLVMGetFirstFunction(module); function != NULL;
+         function = LLVMGetNextFunction(function)) {
+        if (LLVMIsDeclaration(function)) continue;
+        
+        LLVMAddAttributeAtIndex(function, LLVMAttributeFunctionIndex,
+                                LLVMCreateStringAttribute(llvm_context, "target-cpu", 10,
+                                                          target_cache.cpu, strlen(target_cache.cpu)));
+        if (target_cache.features[0] != '\0') {
+            LLVMAddAttributeAtIndex(function, LLVMAttributeFunctionIndex,
+                                    LLVMCreateStringAttribute(llvm_context, "target-features", 15,
+                                                              target_cache.features, strlen(target_cache.features)));
+        }
+    }
+}
+
+static bool has_extension(const char* path, const char* extension) {
+    size_t path_length = strlen(path);
+    size_t extension_length = strlen(extension);
+    return path_length > extension_length && strcmp(path + path_length - extension_length, extension) == 0;
+}
+
+static LLVMTypeRef variable_type(const char* data_type) {
+    if (strcmp(data_type, "i32") == 0) {
+        return LLVMInt32Type();
+    } else if (strcmp(data_type, "bool") == 0) {
+        return LLVMInt1Type();
+    } else if (strcmp(data_type, "str") == 0) {
+        return LLVMPointerType(LLVMInt8Type(), 0);
+    }
+    
+    codegen_error("Erro: Tipo de variável não suportado: %s", data_type);
+}
+
+static LLVMTypeRef channel_type(const char* data_type) {
+    char name[32];
+    snprintf(name, sizeof(name), "tf_channel.%s", data_type);
+    
+    LLVMTypeRef type = LLVMGetTypeByName2(LLVMGetGlobalContext(), name);
+    if (type == NULL) {
+        type = LLVMStructCreateNamed(LLVMGetGlobalContext(), name);
+    }
+    return LLVMPointerType(type, 0);
+}
+
+static const char* channel_element_type(LLVMTypeRef type) {
+    if (LLVMGetTypeKind(type) != LLVMPointerTypeKind) return NULL;
+    
+    LLVMTypeRef element = LLVMGetElementType(type);
+    if (LLVMGetTypeKind(element) != LLVMStructTypeKind) return NULL;
+    
+    const char* name = LLVMGetStructName(element);
+    return name != NULL && strncmp(name, "tf_channel.", 11) == 0 ? name + 11 : NULL;
+}
+
+static int generate_precomputed_prefix(Node* body, GeneratorContext* context, uint64_t max_steps) {
+    ExecutionLimits limits = { max_steps, PARTIAL_EVAL_MAX_MS, PARTIAL_EVAL_MAX_MEM };
+    PrecomputedPrefix prefix;
+    
+    int count = precompute_prefix(body, &limits, &prefix);
+    if (count == 0) return 0;
+    
+    set_debug_location(context, body->data.block.statements[0]->line);
+    
+    for (int i = 0; i < prefix.variable_count; i++) {
+        PrecomputedVariable* variable = &prefix.variables[i];
+        LLVMTypeRef type = variable_type(variable->type);
+        LLVMValueRef alloca = build_entry_alloca(context, type, NULL, variable->name);
+        LLVMValueRef value = variable->str_value != NULL
+            ? build_string_constant(context, variable->str_value, "str")
+            : LLVMConstInt(type, (unsigned long long)(long long)variable->int_value, true);
+        
+        LLVMBuildStore(context->builder, value, alloca);
+        add_symbol(context->symbol_table, variable->name, alloca, type);
+    }
+    
+    if (prefix.output_size > 0) {
+        LLVMValueRef data = LLVMConstString(prefix.output, (unsigned)prefix.output_size, true);
+        LLVMValueRef global = LLVMAddGlobal(context->module, LLVMTypeOf(data), "precomputed_output");
+        LLVMSetInitializer(global, data);
+        LLVMSetGlobalConstant(global, true);
+        LLVMSetLinkage(global, LLVMPrivateLinkage);
+        LLVMSetUnnamedAddress(global, LLVMGlobalUnnamedAddr);
+        
+        LLVMTypeRef param_types[] = { LLVMPointerType(LLVMInt8Type(), 0), LLVMInt64Type() };
+        LLVMValueRef block_func = get_runtime_function(context, "tf_output_block", LLVMVoidType(), param_types, 2);
+        LLVMValueRef args[] = {
+            LLVMConstBitCast(global, LLVMPointerType(LLVMInt8Type(), 0)),
+            LLVMConstInt(LLVMInt64Type(), prefix.output_size, false)
+        };
+        LLVMBuildCall2(context->builder, LLVMGetElementType(LLVMTypeOf(block_func)), block_func, args, 2, "");
+    }
+    
+    free_precomputed_prefix(&prefix);
+    return count;
+}
+
+int generate_llvm_code(Node* ast_root, const char* output_file, const CodegenOptions* options) {
+    initialize_llvm_backend();
+    
+    CodegenTimings* timings = options->timings;
+    double phase_start = tf_monotonic_ms();
+    
+    char target_error[256];
+    LLVMTargetMachineRef machine = get_target_machine(options, target_error, sizeof(target_error));
+    if (machine == NULL) {
+        fprintf(stderr, "%s\n", target_error);
+        return 1;
+    }
     
     GeneratorContext context;
     context.module = LLVMModuleCreateWithName("techflow_module");
+    LLVMSetTarget(context.module, target_cache.triple);
+    LLVMTargetDataRef data_layout = LLVMCreateTargetDataLayout(machine);
+    LLVMSetModuleDataLayout(context.module, data_layout);
+    LLVMDisposeTargetData(data_layout);
     context.builder = LLVMCreateBuilder();
     context.symbol_table = create_symbol_table();
+    context.di_builder = NULL;
+    context.di_file = NULL;
+    context.di_scope = NULL;
+    context.profile = options->profile;
+    context.budget = options->limits.max_steps > 0 || options->limits.max_ms > 0 ||
+                     options->limits.max_mem > 0;
+    context.parallel = false;
+    context.isolated_block = NULL;
+    context.minimal_runtime = options->minimal_runtime;
+    context.alloca_builder = LLVMCreateBuilder();
+    
+    StackSlots main_slots = { NULL, 0, 0 };
+    context.free_slots = &main_slots;
     
-    LLVMTypeRef printf_args[] = { LLVMPointerType(LLVMInt8Type(), 0) };
-    LLVMTypeRef printf_type = LLVMFunctionType(LLVMInt32Type(), printf_args, 1, true);
-    LLVMAddFunction(context.module, "printf", printf_type);
+    InstrumentTable instrument_table = { NULL, 0, 0 };
+    context.instrument = options->instrument ? &instrument_table : NULL;
+    
+    if (options->debug_info) {
+        create_debug_info(&context, options->source_file);
+    }
     
     LLVMTypeRef main_type = LLVMFunctionType(LLVMInt32Type(), NULL, 0, false);
     context.function = LLVMAddFunction(context.module, "main", main_type);
@@ -136,18 +821,81 @@ void generate_llvm_code(Node* ast_root, const char* output_file) {
     LLVMBasicBlockRef entry = LLVMAppendBasicBlock(context.function, "entry");
     LLVMPositionBuilderAtEnd(context.builder, entry);
     
+    if (context.di_builder != NULL) {
+        int line = ast_root != NULL ? ast_root->line : 1;
+        context.di_scope = create_debug_function(&context, context.function, "main", line);
+        set_debug_location(&context, line);
+    }
+    
+    if (context.budget) {
+        LLVMValueRef counter = LLVMAddGlobal(context.module, LLVMInt64Type(), "tf_budget_counter");
+        LLVMSetThreadLocal(counter, !context.minimal_runtime);
+        LLVMSetAlignment(counter, 8);
+        
+        LLVMTypeRef budget_params[] = { LLVMInt64Type(), LLVMInt64Type(), LLVMInt64Type() };
+        LLVMValueRef init_func = get_runtime_function(&context, "tf_budget_init", LLVMVoidType(), budget_params, 3);
+        LLVMValueRef budget_args[] = {
+            LLVMConstInt(LLVMInt64Type(), options->limits.max_steps, false),
+            LLVMConstInt(LLVMInt64Type(), options->limits.max_ms, false),
+            LLVMConstInt(LLVMInt64Type(), options->limits.max_mem, false)
+        };
+        LLVMBuildCall2(context.builder, LLVMGetElementType(LLVMTypeOf(init_func)), init_func, budget_args, 3, "");
+    }
+    
     if (ast_root != NULL && ast_root->type == NODE_PROGRAM) {
-        generate_node(ast_root->data.program.body, &context);
+        Node* body = ast_root->data.program.body;
+        
+        if (options->partial_eval_steps > 0 && !context.budget && context.instrument == NULL &&
+            body != NULL && body->type == NODE_BLOCK) {
+            double partial_start = tf_monotonic_ms();
+            int first = generate_precomputed_prefix(body, &context, options->partial_eval_steps);
+            double partial_ms = tf_monotonic_ms() - partial_start;
+            
+            if (timings != NULL) timings->partial_eval_ms = partial_ms;
+            phase_start += partial_ms;
+            
+            for (int i = first; i < body->data.block.stmt_count; i++) {
+                generate_node(body->data.block.statements[i], &context);
+            }
+        } else {
+            generate_node(body, &context);
+        }
+    }
+    
+    if (LLVMGetNamedFunction(context.module, "tf_spawn") != NULL) {
+        LLVMValueRef wait_func = get_runtime_function(&context, "tf_spawn_wait", LLVMVoidType(), NULL, 0);
+        LLVMBuildCall2(context.builder, LLVMGetElementType(LLVMTypeOf(wait_func)), wait_func, NULL, 0, "");
     }
     
     LLVMBuildRet(context.builder, LLVMConstInt(LLVMInt32Type(), 0, false));
     
+    if (context.instrument != NULL) {
+        register_instrumentation(&context, entry, options->source_file);
+        free(instrument_table.loops);
+    }
+    
+    if (context.di_builder != NULL) {
+        LLVMDIBuilderFinalize(context.di_builder);
+    }
+    
+    set_target_attributes(context.module);
+    
+    double phase_end = tf_monotonic_ms();
+    if (timings != NULL) timings->generate_ms = phase_end - phase_start;
+    phase_start = phase_end;
+    
     char* error = NULL;
     LLVMVerifyModule(context.module, LLVMAbortProcessAction, &error);
     LLVMDisposeMessage(error);
     
+    phase_end = tf_monotonic_ms();
+    if (timings != NULL) timings->verify_ms = phase_end - phase_start;
+    phase_start = phase_end;
+    
     LLVMPassManagerRef pass_manager = LLVMCreatePassManager();
-
+    
+    LLVMAddAnalysisPasses(machine, pass_manager);
+    LLVMAddPromoteMemoryToRegisterPass(pass_manager);
     LLVMAddInstructionCombiningPass(pass_manager);
     LLVMAddReassociatePass(pass_manager);
     LLVMAddGVNPass(pass_manager);
@@ -155,20 +903,51 @@ void generate_llvm_code(Node* ast_root, const char* output_file) {
     LLVMRunPassManager(pass_manager, context.module);
     LLVMDisposePassManager(pass_manager);
     
-    if (LLVMWriteBitcodeToFile(context.module, output_file) != 0) {
+    phase_end = tf_monotonic_ms();
+    if (timings != NULL) timings->optimize_ms = phase_end - phase_start;
+    phase_start = phase_end;
+    
+    LLVMDumpModule(context.module);
+    
+    phase_end = tf_monotonic_ms();
+    if (timings != NULL) timings->dump_ms = phase_end - phase_start;
+    phase_start = phase_end;
+    
+    int status = 0;
+    if (has_extension(output_file, ".o") || has_extension(output_file, ".s")) {
+        char* message = NULL;
+        LLVMCodeGenFileType file_type = has_extension(output_file, ".o") ? LLVMObjectFile : LLVMAssemblyFile;
+        
+        if (LLVMTargetMachineEmitToFile(machine, context.module, (char*)output_file, file_type, &message) != 0) {
+            fprintf(stderr, "Erro ao emitir código para arquivo %s: %s\n", output_file, message);
+            status = 1;
+        }
+        LLVMDisposeMessage(message);
+    } else if (LLVMWriteBitcodeToFile(context.module, output_file) != 0) {
         fprintf(stderr, "Erro ao escrever bitcode para arquivo %s\n", output_file);
+        status = 1;
     }
     
-    LLVMDumpModule(context.module);
+    if (timings != NULL) timings->write_ms = tf_monotonic_ms() - phase_start;
     
     free_symbol_table(context.symbol_table);
+    free(main_slots.allocas);
+    LLVMDisposeBuilder(context.alloca_builder);
+    if (context.di_builder != NULL) {
+        LLVMDisposeDIBuilder(context.di_builder);
+    }
     LLVMDisposeBuilder(context.builder);
     LLVMDisposeModule(context.module);
+    return status;
 }
 
 static LLVMValueRef generate_node(Node* node, GeneratorContext* context) {
     if (node == NULL) return NULL;
     
+    if (node->type != NODE_BLOCK) {
+        set_debug_location(context, node->line);
+    }
+    
     switch (node->type) {
         case NODE_BLOCK:
             return generate_block(node, context);
@@ -182,6 +961,20 @@ static LLVMValueRef generate_node(Node* node, GeneratorContext* context) {
             return generate_while_stmt(node, context);
         case NODE_REPEAT:
             return generate_repeat_stmt(node, context);
+        case NODE_PARALLEL_FOR:
+            return generate_parallel_for(node, context);
+        case NODE_SPAWN:
+            return generate_spawn(node, context);
+        case NODE_CHANNEL_DECL:
+            return generate_channel_decl(node, context);
+        case NODE_SEND:
+            return generate_send(node, context);
+        case NODE_RECEIVE:
+            return generate_receive(node, context);
+        case NODE_CLOSE:
+            return generate_close(node, context);
+        case NODE_RECEIVE_LOOP:
+            return generate_receive_loop(node, context);
         case NODE_SWITCH:
             return generate_switch_stmt(node, context);
         case NODE_PRINT:
@@ -195,24 +988,32 @@ static LLVMValueRef generate_node(Node* node, GeneratorContext* context) {
         case NODE_BOOL_VAL:
             return LLVMConstInt(LLVMInt1Type(), node->data.bool_value, false);
         case NODE_STRING_VAL:
-            return LLVMBuildGlobalStringPtr(context->builder, node->data.str_value, "str");
+            return build_string_constant(context, node->data.str_value, "str");
+        case NODE_READ:
+            return generate_read_expr(node, context);
         case NODE_IDENTIFIER: {
             Symbol* symbol = find_symbol(context->symbol_table, node->data.str_value);
             if (symbol == NULL) {
-                fprintf(stderr, "Erro: Variável '%s' não definida\n", node->data.str_value);
-                exit(1);
+                codegen_error("Erro: Variável '%s' não definida", node->data.str_value);
+            }
+            if (channel_element_type(symbol->type) != NULL) {
+                codegen_error("Erro: Canal '%s' só pode ser usado em send, receive, close e stream",
+                              node->data.str_value);
             }
             return LLVMBuildLoad2(context->builder, symbol->type, symbol->value, node->data.str_value);
         }
         default:
-            fprintf(stderr, "Erro: Tipo de nó não suportado: %d\n", node->type);
-            exit(1);
+            codegen_error("Erro: Tipo de nó não suportado: %d", node->type);
     }
     
     return NULL;
 }
 
-static LLVMValueRef generate_block(Node* node, GeneratorContext* context) {
+static LLVMValueRef generate_statements(Node* node, GeneratorContext* context) {
+    if (node == NULL || node->type != NODE_BLOCK) {
+        return generate_node(node, context);
+    }
+    
     LLVMValueRef last_value = NULL;
     
     for (int i = 0; i < node->data.block.stmt_count; i++) {
@@ -222,36 +1023,41 @@ static LLVMValueRef generate_block(Node* node, GeneratorContext* context) {
     return last_value;
 }
 
+static LLVMValueRef generate_block(Node* node, GeneratorContext* context) {
+    int scope = enter_scope(context);
+    LLVMValueRef last_value = generate_statements(node, context);
+    leave_scope(context, scope);
+    return last_value;
+}
+
+static LLVMValueRef default_value(GeneratorContext* context, const char* data_type) {
+    if (strcmp(data_type, "str") == 0) {
+        return build_string_constant(context, "", "empty_str");
+    }
+    return LLVMConstNull(variable_type(data_type));
+}
+
 static LLVMValueRef generate_var_decl(Node* node, GeneratorContext* context) {
-    LLVMTypeRef type;
+    LLVMTypeRef type = variable_type(node->data.var_decl.data_type);
+    LLVMValueRef init_val = NULL;
+    if (node->data.var_decl.init_expr != NULL) {
+        init_val = generate_expression(node->data.var_decl.init_expr, context);
+    }
     
-    if (strcmp(node->data.var_decl.data_type, "i32") == 0) {
-        type = LLVMInt32Type();
-    } else if (strcmp(node->data.var_decl.data_type, "bool") == 0) {
-        type = LLVMInt1Type();
-    } else if (strcmp(node->data.var_decl.data_type, "str") == 0) {
-        type = LLVMPointerType(LLVMInt8Type(), 0);
-    } else {
-        fprintf(stderr, "Erro: Tipo de variável não suportado: %s\n", node->data.var_decl.data_type);
-        exit(1);
+    Symbol* symbol = find_local_symbol(context->symbol_table, node->data.var_decl.name);
+    if (symbol != NULL && symbol->slot) {
+        release_stack_slot(context, symbol);
     }
     
-    LLVMValueRef alloca = LLVMBuildAlloca(context->builder, type, node->data.var_decl.name);
+    LLVMValueRef alloca = acquire_stack_slot(context, type, node->data.var_decl.name);
+    symbol = add_symbol(context->symbol_table, node->data.var_decl.name, alloca, type);
+    symbol->slot = true;
+    build_lifetime_marker(context, "llvm.lifetime.start", symbol);
     
-    add_symbol(context->symbol_table, node->data.var_decl.name, alloca, type);
-    
-    if (node->data.var_decl.init_expr != NULL) {
-        LLVMValueRef init_val = generate_expression(node->data.var_decl.init_expr, context);
-        LLVMBuildStore(context->builder, init_val, alloca);
-    } else {
-        if (strcmp(node->data.var_decl.data_type, "i32") == 0) {
-            LLVMBuildStore(context->builder, LLVMConstInt(LLVMInt32Type(), 0, false), alloca);
-        } else if (strcmp(node->data.var_decl.data_type, "bool") == 0) {
-            LLVMBuildStore(context->builder, LLVMConstInt(LLVMInt1Type(), 0, false), alloca);
-        } else if (strcmp(node->data.var_decl.data_type, "str") == 0) {
-            LLVMBuildStore(context->builder, LLVMBuildGlobalStringPtr(context->builder, "", "empty_str"), alloca);
-        }
-    }
+    if (init_val == NULL) {
+        init_val = default_value(context, node->data.var_decl.data_type);
+    }
+    LLVMBuildStore(context->builder, init_val, alloca);
     
     return alloca;
 }
@@ -264,15 +1070,60 @@ static LLVMValueRef generate_assignment(Node* node, GeneratorContext* context) {
     Symbol* symbol = find_symbol(context->symbol_table, node->data.assign.name);
     
     if (symbol == NULL) {
-        fprintf(stderr, "Erro: Variável '%s' não definida\n", node->data.assign.name);
-        exit(1);
+        codegen_error("Erro: Variável '%s' não definida", node->data.assign.name);
+    }
+    
+    if (symbol->read_only) {
+        codegen_error("Erro: Variável '%s' não pode ser modificada dentro de %s", node->data.assign.name,
+                      context->isolated_block);
+    }
+    
+    if (channel_element_type(symbol->type) != NULL) {
+        codegen_error("Erro: Canal '%s' não pode ser reatribuído", node->data.assign.name);
     }
     
     LLVMValueRef value = generate_expression(node->data.assign.value, context);
     return LLVMBuildStore(context->builder, value, symbol->value);
 }
 
+static LLVMValueRef generate_logical_op(Node* node, GeneratorContext* context) {
+    bool is_and = strcmp(node->data.binary_op.operator, "AND") == 0;
+    
+    LLVMValueRef left = generate_expression(node->data.binary_op.left, context);
+    LLVMBasicBlockRef left_block = LLVMGetInsertBlock(context->builder);
+    
+    LLVMBasicBlockRef rhs_block = LLVMAppendBasicBlock(context->function, is_and ? "and_rhs" : "or_rhs");
+    LLVMBasicBlockRef merge_block = LLVMAppendBasicBlock(context->function, is_and ? "and_end" : "or_end");
+    
+    if (is_and) {
+        LLVMBuildCondBr(context->builder, left, rhs_block, merge_block);
+    } else {
+        LLVMBuildCondBr(context->builder, left, merge_block, rhs_block);
+    }
+    
+    LLVMPositionBuilderAtEnd(context->builder, rhs_block);
+    LLVMValueRef right = generate_expression(node->data.binary_op.right, context);
+    LLVMBasicBlockRef right_block = LLVMGetInsertBlock(context->builder);
+    LLVMBuildBr(context->builder, merge_block);
+    
+    LLVMPositionBuilderAtEnd(context->builder, merge_block);
+    LLVMValueRef phi = LLVMBuildPhi(context->builder, LLVMInt1Type(), is_and ? "andtmp" : "ortmp");
+    LLVMValueRef incoming_values[] = {
+        LLVMConstInt(LLVMInt1Type(), is_and ? 0 : 1, false),
+        right
+    };
+    LLVMBasicBlockRef incoming_blocks[] = { left_block, right_block };
+    LLVMAddIncoming(phi, incoming_values, incoming_blocks, 2);
+    
+    return phi;
+}
+
 static LLVMValueRef generate_binary_op(Node* node, GeneratorContext* context) {
+    if (strcmp(node->data.binary_op.operator, "AND") == 0 ||
+        strcmp(node->data.binary_op.operator, "OR") == 0) {
+        return generate_logical_op(node, context);
+    }
+    
     LLVMValueRef left = generate_expression(node->data.binary_op.left, context);
     LLVMValueRef right = generate_expression(node->data.binary_op.right, context);
     
@@ -288,6 +1139,16 @@ static LLVMValueRef generate_binary_op(Node* node, GeneratorContext* context) {
         return LLVMBuildSRem(context->builder, left, right, "modtmp");
     }
     
+    else if (LLVMGetTypeKind(LLVMTypeOf(left)) == LLVMPointerTypeKind &&
+             (strcmp(node->data.binary_op.operator, "<") == 0 ||
+              strcmp(node->data.binary_op.operator, ">") == 0 ||
+              strcmp(node->data.binary_op.operator, "LE") == 0 ||
+              strcmp(node->data.binary_op.operator, "GE") == 0 ||
+              strcmp(node->data.binary_op.operator, "EQ") == 0 ||
+              strcmp(node->data.binary_op.operator, "NEQ") == 0)) {
+        return build_string_comparison(context, node->data.binary_op.operator, left, right);
+    }
+    
     else if (strcmp(node->data.binary_op.operator, "<") == 0) {
         return LLVMBuildICmp(context->builder, LLVMIntSLT, left, right, "lttmp");
     } else if (strcmp(node->data.binary_op.operator, ">") == 0) {
@@ -302,12 +1163,6 @@ static LLVMValueRef generate_binary_op(Node* node, GeneratorContext* context) {
         return LLVMBuildICmp(context->builder, LLVMIntNE, left, right, "netmp");
     }
     
-    else if (strcmp(node->data.binary_op.operator, "AND") == 0) {
-        return LLVMBuildAnd(context->builder, left, right, "andtmp");
-    } else if (strcmp(node->data.binary_op.operator, "OR") == 0) {
-        return LLVMBuildOr(context->builder, left, right, "ortmp");
-    }
-    
     else if (strcmp(node->data.binary_op.operator, "CONCAT") == 0) {
         LLVMValueRef concat_func = LLVMGetNamedFunction(context->module, "concat_strings");
         if (!concat_func) {
@@ -319,26 +1174,29 @@ static LLVMValueRef generate_binary_op(Node* node, GeneratorContext* context) {
             LLVMTypeRef func_type = LLVMFunctionType(ret_type, param_types, 2, 0);
             concat_func = LLVMAddFunction(context->module, "concat_strings", func_type);
         }
-
+        
         LLVMTypeRef left_type = LLVMTypeOf(left);
         if (LLVMGetTypeKind(left_type) == LLVMIntegerTypeKind && 
             LLVMGetIntTypeWidth(left_type) == 32) {
             left = int_to_string(context, left);
+        } else if (LLVMGetTypeKind(left_type) == LLVMIntegerTypeKind) {
+            left = bool_to_string(context, left);
         }
-
+        
         LLVMTypeRef right_type = LLVMTypeOf(right);
         if (LLVMGetTypeKind(right_type) == LLVMIntegerTypeKind && 
             LLVMGetIntTypeWidth(right_type) == 32) {
             right = int_to_string(context, right);
+        } else if (LLVMGetTypeKind(right_type) == LLVMIntegerTypeKind) {
+            right = bool_to_string(context, right);
         }
-
+        
         LLVMTypeRef func_type = LLVMGetElementType(LLVMTypeOf(concat_func));
         LLVMValueRef args[] = { left, right };
         return LLVMBuildCall2(context->builder, func_type, concat_func, args, 2, "concat_result");
     }
     
-    fprintf(stderr, "Erro: Operador binário não suportado: %s\n", node->data.binary_op.operator);
-    exit(1);
+    codegen_error("Erro: Operador binário não suportado: %s", node->data.binary_op.operator);
 }
 
 static LLVMValueRef generate_unary_op(Node* node, GeneratorContext* context) {
@@ -352,8 +1210,7 @@ static LLVMValueRef generate_unary_op(Node* node, GeneratorContext* context) {
         return LLVMBuildNot(context->builder, operand, "nottmp");
     }
     
-    fprintf(stderr, "Erro: Operador unário não suportado: %s\n", node->data.unary_op.operator);
-    exit(1);
+    codegen_error("Erro: Operador unário não suportado: %s", node->data.unary_op.operator);
 }
 
 static LLVMValueRef generate_if_stmt(Node* node, GeneratorContext* context) {
@@ -364,12 +1221,16 @@ static LLVMValueRef generate_if_stmt(Node* node, GeneratorContext* context) {
                                     LLVMAppendBasicBlock(context->function, "else") : NULL;
     LLVMBasicBlockRef merge_block = LLVMAppendBasicBlock(context->function, "ifcont");
     
+    LLVMValueRef branch;
     if (else_block) {
-        LLVMBuildCondBr(context->builder, condition, then_block, else_block);
+        branch = LLVMBuildCondBr(context->builder, condition, then_block, else_block);
     } else {
-        LLVMBuildCondBr(context->builder, condition, then_block, merge_block);
+        branch = LLVMBuildCondBr(context->builder, condition, then_block, merge_block);
     }
     
+    const int arms[] = { 0, 1 };
+    set_branch_weights(context, branch, node, arms, 2);
+    
     LLVMPositionBuilderAtEnd(context->builder, then_block);
     generate_node(node->data.if_stmt.then_branch, context);
     LLVMBuildBr(context->builder, merge_block);
@@ -389,16 +1250,21 @@ static LLVMValueRef generate_while_stmt(Node* node, GeneratorContext* context) {
     LLVMBasicBlockRef cond_block = LLVMAppendBasicBlock(context->function, "while_cond");
     LLVMBasicBlockRef body_block = LLVMAppendBasicBlock(context->function, "while_body");
     LLVMBasicBlockRef end_block = LLVMAppendBasicBlock(context->function, "while_end");
+    LLVMValueRef loop_counter = create_loop_counter(context, node, "stream");
     
     LLVMBuildBr(context->builder, cond_block);
     
     LLVMPositionBuilderAtEnd(context->builder, cond_block);
     LLVMValueRef condition = generate_expression(node->data.while_stmt.condition, context);
-    LLVMBuildCondBr(context->builder, condition, body_block, end_block);
+    LLVMValueRef branch = LLVMBuildCondBr(context->builder, condition, body_block, end_block);
+    
+    const int arms[] = { 0, 1 };
+    set_branch_weights(context, branch, node, arms, 2);
     
     LLVMPositionBuilderAtEnd(context->builder, body_block);
+    count_loop_iterations(context, loop_counter, LLVMConstInt(LLVMInt64Type(), 1, false));
     generate_node(node->data.while_stmt.body, context);
-    LLVMBuildBr(context->builder, cond_block);
+    build_back_edge(context, cond_block);
     
     LLVMPositionBuilderAtEnd(context->builder, end_block);
     
@@ -408,23 +1274,247 @@ static LLVMValueRef generate_while_stmt(Node* node, GeneratorContext* context) {
 static LLVMValueRef generate_repeat_stmt(Node* node, GeneratorContext* context) {
     LLVMBasicBlockRef body_block = LLVMAppendBasicBlock(context->function, "repeat_body");
     LLVMBasicBlockRef cond_block = LLVMAppendBasicBlock(context->function, "repeat_cond");
+    LLVMBasicBlockRef latch_block = LLVMAppendBasicBlock(context->function, "repeat_latch");
     LLVMBasicBlockRef end_block = LLVMAppendBasicBlock(context->function, "repeat_end");
+    LLVMValueRef loop_counter = create_loop_counter(context, node, "repeat");
     
     LLVMBuildBr(context->builder, body_block);
     
     LLVMPositionBuilderAtEnd(context->builder, body_block);
-    generate_node(node->data.repeat_stmt.body, context);
+    count_loop_iterations(context, loop_counter, LLVMConstInt(LLVMInt64Type(), 1, false));
+    int scope = enter_scope(context);
+    generate_statements(node->data.repeat_stmt.body, context);
     LLVMBuildBr(context->builder, cond_block);
     
     LLVMPositionBuilderAtEnd(context->builder, cond_block);
     LLVMValueRef condition = generate_expression(node->data.repeat_stmt.condition, context);
-    LLVMBuildCondBr(context->builder, condition, end_block, body_block);
+    leave_scope(context, scope);
+    LLVMValueRef branch = LLVMBuildCondBr(context->builder, condition, end_block, latch_block);
+    
+    const int arms[] = { 1, 0 };
+    set_branch_weights(context, branch, node, arms, 2);
+    
+    LLVMPositionBuilderAtEnd(context->builder, latch_block);
+    build_back_edge(context, body_block);
     
     LLVMPositionBuilderAtEnd(context->builder, end_block);
     
     return NULL;
 }
 
+static int reduce_op_code(const char* op) {
+    if (strcmp(op, "+") == 0) return TF_REDUCE_ADD;
+    if (strcmp(op, "*") == 0) return TF_REDUCE_MUL;
+    if (strcmp(op, "AND") == 0) return TF_REDUCE_AND;
+    return TF_REDUCE_OR;
+}
+
+static LLVMValueRef build_reduce_combine(GeneratorContext* context, int op, LLVMValueRef left, LLVMValueRef right) {
+    switch (op) {
+        case TF_REDUCE_ADD:
+            return LLVMBuildAdd(context->builder, left, right, "reduce_add");
+        case TF_REDUCE_MUL:
+            return LLVMBuildMul(context->builder, left, right, "reduce_mul");
+        case TF_REDUCE_AND:
+            return LLVMBuildAnd(context->builder, left, right, "reduce_and");
+        default:
+            return LLVMBuildOr(context->builder, left, right, "reduce_or");
+    }
+}
+
+static LLVMValueRef generate_parallel_body(Node* node, GeneratorContext* context,
+                                           Symbol** reduce_symbols, int* reduce_ops) {
+    LLVMTypeRef i8_ptr = LLVMPointerType(LLVMInt8Type(), 0);
+    LLVMTypeRef i32_ptr = LLVMPointerType(LLVMInt32Type(), 0);
+    LLVMTypeRef param_types[] = { i8_ptr, LLVMInt32Type(), LLVMInt32Type(), i32_ptr };
+    LLVMTypeRef body_type = LLVMFunctionType(LLVMVoidType(), param_types, 4, false);
+    
+    LLVMValueRef body_func = LLVMAddFunction(context->module, "tf_parallel_body", body_type);
+    LLVMSetLinkage(body_func, LLVMInternalLinkage);
+    
+    LLVMValueRef loop_counter = create_loop_counter(context, node, "stream parallel");
+    
+    StackSlots body_slots = { NULL, 0, 0 };
+    GeneratorContext body_context = *context;
+    body_context.function = body_func;
+    body_context.symbol_table = create_symbol_table();
+    body_context.parallel = true;
+    body_context.isolated_block = "stream parallel";
+    body_context.free_slots = &body_slots;
+    
+    if (context->di_builder != NULL) {
+        body_context.di_scope = create_debug_function(context, body_func, "tf_parallel_body", node->line);
+    }
+    
+    LLVMBasicBlockRef entry = LLVMAppendBasicBlock(body_func, "entry");
+    LLVMPositionBuilderAtEnd(context->builder, entry);
+    set_debug_location(&body_context, node->line);
+    
+    LLVMValueRef env = LLVMBuildBitCast(context->builder, LLVMGetParam(body_func, 0),
+                                        LLVMPointerType(i8_ptr, 0), "env");
+    SymbolTable* outer = context->symbol_table;
+    
+    for (int k = 0; k < outer->symbol_count; k++) {
+        LLVMValueRef index = LLVMConstInt(LLVMInt32Type(), k, false);
+        LLVMValueRef slot = LLVMBuildGEP2(context->builder, i8_ptr, env, &index, 1, "env_slot");
+        LLVMValueRef raw = LLVMBuildLoad2(context->builder, i8_ptr, slot, "env_ptr");
+        LLVMValueRef typed = LLVMBuildBitCast(context->builder, raw,
+                                             LLVMPointerType(outer->symbols[k].type, 0), outer->symbols[k].name);
+        push_symbol(body_context.symbol_table, outer->symbols[k].name, typed, outer->symbols[k].type)->read_only = true;
+    }
+    
+    int reduce_count = node->data.parallel_for.reduce_count;
+    LLVMValueRef locals[reduce_count > 0 ? reduce_count : 1];
+    
+    for (int r = 0; r < reduce_count; r++) {
+        LLVMTypeRef type = reduce_symbols[r]->type;
+        locals[r] = LLVMBuildAlloca(context->builder, type, reduce_symbols[r]->name);
+        LLVMBuildStore(context->builder, LLVMConstInt(type, tf_parallel_identity(reduce_ops[r]), false), locals[r]);
+        add_symbol(body_context.symbol_table, reduce_symbols[r]->name, locals[r], type);
+    }
+    
+    LLVMValueRef counter = LLVMBuildAlloca(context->builder, LLVMInt32Type(), node->data.parallel_for.var_name);
+    LLVMBuildStore(context->builder, LLVMGetParam(body_func, 1), counter);
+    add_symbol(body_context.symbol_table, node->data.parallel_for.var_name, counter, LLVMInt32Type());
+    
+    LLVMValueRef index_slot = LLVMBuildAlloca(context->builder, LLVMInt32Type(), "parallel_index");
+    LLVMBuildStore(context->builder, LLVMGetParam(body_func, 1), index_slot);
+    
+    if (loop_counter != NULL) {
+        LLVMValueRef chunk = LLVMBuildSub(context->builder, LLVMGetParam(body_func, 2), LLVMGetParam(body_func, 1),
+                                          "chunk_size");
+        count_loop_iterations(&body_context, loop_counter,
+                              LLVMBuildSExt(context->builder, chunk, LLVMInt64Type(), "chunk_size64"));
+    }
+    
+    LLVMBasicBlockRef cond_block = LLVMAppendBasicBlock(body_func, "parallel_cond");
+    LLVMBasicBlockRef loop_block = LLVMAppendBasicBlock(body_func, "parallel_body");
+    LLVMBasicBlockRef end_block = LLVMAppendBasicBlock(body_func, "parallel_end");
+    
+    LLVMBuildBr(context->builder, cond_block);
+    
+    LLVMPositionBuilderAtEnd(context->builder, cond_block);
+    LLVMValueRef index = LLVMBuildLoad2(context->builder, LLVMInt32Type(), index_slot, "index");
+    LLVMValueRef in_range = LLVMBuildICmp(context->builder, LLVMIntSLT, index, LLVMGetParam(body_func, 2), "in_range");
+    LLVMBuildCondBr(context->builder, in_range, loop_block, end_block);
+    
+    LLVMPositionBuilderAtEnd(context->builder, loop_block);
+    LLVMBuildStore(context->builder, index, counter);
+    generate_node(node->data.parallel_for.body, &body_context);
+    LLVMValueRef next = LLVMBuildAdd(context->builder, index, LLVMConstInt(LLVMInt32Type(), 1, false), "next_index");
+    LLVMBuildStore(context->builder, next, index_slot);
+    build_back_edge(&body_context, cond_block);
+    
+    LLVMPositionBuilderAtEnd(context->builder, end_block);
+    for (int r = 0; r < reduce_count; r++) {
+        LLVMValueRef partial_index = LLVMConstInt(LLVMInt32Type(), r, false);
+        LLVMValueRef partial_slot = LLVMBuildGEP2(context->builder, LLVMInt32Type(), LLVMGetParam(body_func, 3),
+                                                  &partial_index, 1, "partial_slot");
+        LLVMValueRef partial = LLVMBuildLoad2(context->builder, LLVMInt32Type(), partial_slot, "partial");
+        LLVMValueRef local = LLVMBuildLoad2(context->builder, reduce_symbols[r]->type, locals[r], "local");
+        LLVMValueRef widened = LLVMBuildZExt(context->builder, local, LLVMInt32Type(), "local_i32");
+        LLVMBuildStore(context->builder, build_reduce_combine(&body_context, reduce_ops[r], partial, widened), partial_slot);
+    }
+    LLVMBuildRetVoid(context->builder);
+    
+    free_symbol_table(body_context.symbol_table);
+    free(body_slots.allocas);
+    
+    return body_func;
+}
+
+static LLVMValueRef generate_parallel_for(Node* node, GeneratorContext* context) {
+    require_full_runtime(context, "stream parallel");
+    
+    LLVMTypeRef i8_ptr = LLVMPointerType(LLVMInt8Type(), 0);
+    LLVMTypeRef i32_ptr = LLVMPointerType(LLVMInt32Type(), 0);
+    
+    LLVMValueRef start = generate_expression(node->data.parallel_for.start, context);
+    LLVMValueRef end = generate_expression(node->data.parallel_for.end, context);
+    
+    int reduce_count = node->data.parallel_for.reduce_count;
+    int reduce_ops[reduce_count > 0 ? reduce_count : 1];
+    Symbol* reduce_symbols[reduce_count > 0 ? reduce_count : 1];
+    
+    for (int r = 0; r < reduce_count; r++) {
+        Symbol* symbol = find_symbol(context->symbol_table, node->data.parallel_for.reduce_vars[r]);
+        if (symbol == NULL) {
+            codegen_error("Erro: Variável '%s' não definida", node->data.parallel_for.reduce_vars[r]);
+        }
+        if (symbol->read_only) {
+            codegen_error("Erro: Variável '%s' não pode ser modificada dentro de %s", symbol->name,
+                          context->isolated_block);
+        }
+        
+        reduce_ops[r] = reduce_op_code(node->data.parallel_for.reduce_ops[r]);
+        
+        bool is_arithmetic = reduce_ops[r] == TF_REDUCE_ADD || reduce_ops[r] == TF_REDUCE_MUL;
+        if (LLVMGetTypeKind(symbol->type) != LLVMIntegerTypeKind ||
+            LLVMGetIntTypeWidth(symbol->type) != (is_arithmetic ? 32 : 1)) {
+            codegen_error("Erro: Tipo incompatível na redução de '%s'", symbol->name);
+        }
+        
+        reduce_symbols[r] = symbol;
+    }
+    
+    SymbolTable* outer = context->symbol_table;
+    int env_count = outer->symbol_count > 0 ? outer->symbol_count : 1;
+    LLVMValueRef env = build_entry_alloca(context, i8_ptr, LLVMConstInt(LLVMInt32Type(), env_count, false),
+                                          "parallel_env");
+    for (int k = 0; k < outer->symbol_count; k++) {
+        LLVMValueRef index = LLVMConstInt(LLVMInt32Type(), k, false);
+        LLVMValueRef slot = LLVMBuildGEP2(context->builder, i8_ptr, env, &index, 1, "env_slot");
+        LLVMBuildStore(context->builder, LLVMBuildBitCast(context->builder, outer->symbols[k].value, i8_ptr, "env_ptr"), slot);
+    }
+    
+    int value_count = reduce_count > 0 ? reduce_count : 1;
+    LLVMValueRef ops = build_entry_alloca(context, LLVMInt32Type(),
+                                          LLVMConstInt(LLVMInt32Type(), value_count, false), "reduce_ops");
+    LLVMValueRef values = build_entry_alloca(context, LLVMInt32Type(),
+                                             LLVMConstInt(LLVMInt32Type(), value_count, false), "reduce_values");
+    for (int r = 0; r < reduce_count; r++) {
+        LLVMValueRef index = LLVMConstInt(LLVMInt32Type(), r, false);
+        LLVMValueRef op_slot = LLVMBuildGEP2(context->builder, LLVMInt32Type(), ops, &index, 1, "op_slot");
+        LLVMBuildStore(context->builder, LLVMConstInt(LLVMInt32Type(), reduce_ops[r], false), op_slot);
+        
+        LLVMValueRef value_slot = LLVMBuildGEP2(context->builder, LLVMInt32Type(), values, &index, 1, "value_slot");
+        LLVMValueRef current = LLVMBuildLoad2(context->builder, reduce_symbols[r]->type, reduce_symbols[r]->value, "current");
+        LLVMBuildStore(context->builder, LLVMBuildZExt(context->builder, current, LLVMInt32Type(), "current_i32"), value_slot);
+    }
+    
+    LLVMBasicBlockRef current_block = LLVMGetInsertBlock(context->builder);
+    LLVMValueRef body_func = generate_parallel_body(node, context, reduce_symbols, reduce_ops);
+    LLVMPositionBuilderAtEnd(context->builder, current_block);
+    set_debug_location(context, node->line);
+    
+    LLVMTypeRef body_param_types[] = { i8_ptr, LLVMInt32Type(), LLVMInt32Type(), i32_ptr };
+    LLVMTypeRef body_ptr_type = LLVMPointerType(LLVMFunctionType(LLVMVoidType(), body_param_types, 4, false), 0);
+    LLVMTypeRef param_types[] = { LLVMInt32Type(), LLVMInt32Type(), body_ptr_type, i8_ptr, i32_ptr, i32_ptr, LLVMInt32Type() };
+    LLVMValueRef parallel_func = get_runtime_function(context, "tf_parallel_for", LLVMVoidType(), param_types, 7);
+    
+    LLVMTypeRef func_type = LLVMGetElementType(LLVMTypeOf(parallel_func));
+    LLVMValueRef args[] = {
+        start,
+        end,
+        body_func,
+        LLVMBuildBitCast(context->builder, env, i8_ptr, "env_arg"),
+        ops,
+        values,
+        LLVMConstInt(LLVMInt32Type(), reduce_count, false)
+    };
+    LLVMBuildCall2(context->builder, func_type, parallel_func, args, 7, "");
+    
+    for (int r = 0; r < reduce_count; r++) {
+        LLVMValueRef index = LLVMConstInt(LLVMInt32Type(), r, false);
+        LLVMValueRef value_slot = LLVMBuildGEP2(context->builder, LLVMInt32Type(), values, &index, 1, "value_slot");
+        LLVMValueRef reduced = LLVMBuildLoad2(context->builder, LLVMInt32Type(), value_slot, "reduced");
+        LLVMBuildStore(context->builder, LLVMBuildTrunc(context->builder, reduced, reduce_symbols[r]->type, "reduced_val"),
+                       reduce_symbols[r]->value);
+    }
+    
+    return NULL;
+}
+
 static LLVMValueRef generate_switch_stmt(Node* node, GeneratorContext* context) {
     LLVMValueRef condition = generate_expression(node->data.switch_stmt.condition, context);
     
@@ -448,6 +1538,14 @@ static LLVMValueRef generate_switch_stmt(Node* node, GeneratorContext* context)
         LLVMBuildBr(context->builder, end_block);
     }
     
+    int case_count = node->data.switch_stmt.case_count;
+    int arms[case_count + 1];
+    arms[0] = case_count;
+    for (int i = 0; i < case_count; i++) {
+        arms[i + 1] = i;
+    }
+    set_branch_weights(context, switch_inst, node, arms, case_count + 1);
+    
     if (node->data.switch_stmt.default_case) {
         LLVMBasicBlockRef default_block = LLVMGetSwitchDefaultDest(switch_inst);
         LLVMPositionBuilderAtEnd(context->builder, default_block);
@@ -461,42 +1559,677 @@ static LLVMValueRef generate_switch_stmt(Node* node, GeneratorContext* context)
 }
 
 static LLVMValueRef generate_print_stmt(Node* node, GeneratorContext* context) {
-    LLVMValueRef printf_func = LLVMGetNamedFunction(context->module, "printf");
+    LLVMValueRef expr = generate_expression(node->data.print_stmt.expr, context);
+    LLVMTypeRef expr_type = LLVMTypeOf(expr);
+    LLVMValueRef log_func;
+    
+    if (LLVMGetTypeKind(expr_type) == LLVMIntegerTypeKind && LLVMGetIntTypeWidth(expr_type) != 1) {
+        LLVMTypeRef param_types[] = { LLVMInt32Type() };
+        log_func = get_runtime_function(context, "tf_log_i32", LLVMVoidType(), param_types, 1);
+    } else {
+        if (LLVMGetTypeKind(expr_type) == LLVMIntegerTypeKind) {
+            expr = bool_to_string(context, expr);
+        }
+        LLVMTypeRef param_types[] = { LLVMPointerType(LLVMInt8Type(), 0) };
+        log_func = get_runtime_function(context, "tf_log_str", LLVMVoidType(), param_types, 1);
+    }
     
-    if (!printf_func) {
-        fprintf(stderr, "Erro: Função printf não encontrada\n");
-        exit(1);
+    LLVMTypeRef func_type = LLVMGetElementType(LLVMTypeOf(log_func));
+    LLVMValueRef args[] = { expr };
+    return LLVMBuildCall2(context->builder, func_type, log_func, args, 1, "");
+}
+
+static LLVMValueRef generate_read_expr(Node* node, GeneratorContext* context) {
+    LLVMValueRef read_func;
+    
+    if (context->isolated_block != NULL && strcmp(context->isolated_block, "stream parallel") == 0) {
+        codegen_error("Erro: reader não pode ser usado dentro de stream parallel");
     }
     
-    LLVMValueRef expr = generate_expression(node->data.print_stmt.expr, context);
-    LLVMTypeRef expr_type = LLVMTypeOf(expr);
+    if (strcmp(node->data.read_expr.data_type, "str") == 0) {
+        read_func = get_runtime_function(context, "tf_read_str", LLVMPointerType(LLVMInt8Type(), 0), NULL, 0);
+    } else {
+        read_func = get_runtime_function(context, "tf_read_i32", LLVMInt32Type(), NULL, 0);
+    }
     
-    const char* format;
-    if (LLVMGetTypeKind(expr_type) == LLVMIntegerTypeKind) {
-        if (LLVMGetIntTypeWidth(expr_type) == 1) {
-            format = "%s\n";
-            
-            LLVMValueRef bool_to_str_func = LLVMGetNamedFunction(context->module, "bool_to_string");
-            if (!bool_to_str_func) {
-                LLVMTypeRef param_types[] = { LLVMInt1Type() };
-                LLVMTypeRef ret_type = LLVMPointerType(LLVMInt8Type(), 0);
-                LLVMTypeRef func_type = LLVMFunctionType(ret_type, param_types, 1, 0);
-                bool_to_str_func = LLVMAddFunction(context->module, "bool_to_string", func_type);
-            }
+    LLVMTypeRef func_type = LLVMGetElementType(LLVMTypeOf(read_func));
+    return LLVMBuildCall2(context->builder, func_type, read_func, NULL, 0, "read_result");
+}
+
+static Symbol* lookup_channel(GeneratorContext* context, const char* name) {
+    Symbol* symbol = find_symbol(context->symbol_table, name);
+    
+    if (symbol == NULL) {
+        codegen_error("Erro: Variável '%s' não definida", name);
+    }
+    if (channel_element_type(symbol->type) == NULL) {
+        codegen_error("Erro: Variável '%s' não é um canal", name);
+    }
+    return symbol;
+}
 
-            LLVMTypeRef func_type = LLVMGetElementType(LLVMTypeOf(bool_to_str_func));
-            LLVMValueRef args[] = { expr };
-            expr = LLVMBuildCall2(context->builder, func_type, bool_to_str_func, args, 1, "bool_str");
+static LLVMValueRef load_channel(GeneratorContext* context, Symbol* symbol) {
+    LLVMValueRef channel = LLVMBuildLoad2(context->builder, symbol->type, symbol->value, symbol->name);
+    return LLVMBuildBitCast(context->builder, channel, LLVMPointerType(LLVMInt8Type(), 0), "channel");
+}
+
+static LLVMValueRef channel_word(GeneratorContext* context, LLVMValueRef value) {
+    LLVMTypeRef type = LLVMTypeOf(value);
+    
+    if (LLVMGetTypeKind(type) == LLVMPointerTypeKind) {
+        return LLVMBuildPtrToInt(context->builder, value, LLVMInt64Type(), "word");
+    }
+    if (LLVMGetIntTypeWidth(type) == 1) {
+        return LLVMBuildZExt(context->builder, value, LLVMInt64Type(), "word");
+    }
+    return LLVMBuildSExt(context->builder, value, LLVMInt64Type(), "word");
+}
+
+static LLVMValueRef channel_value(GeneratorContext* context, LLVMValueRef word, LLVMTypeRef type) {
+    if (LLVMGetTypeKind(type) == LLVMPointerTypeKind) {
+        return LLVMBuildIntToPtr(context->builder, word, type, "received");
+    }
+    return LLVMBuildTrunc(context->builder, word, type, "received");
+}
+
+static LLVMValueRef build_channel_next(GeneratorContext* context, LLVMValueRef channel, LLVMValueRef slot) {
+    LLVMTypeRef i8_ptr = LLVMPointerType(LLVMInt8Type(), 0);
+    LLVMTypeRef param_types[] = { i8_ptr, LLVMPointerType(LLVMInt64Type(), 0) };
+    LLVMValueRef next_func = get_runtime_function(context, "tf_chan_next", LLVMInt32Type(), param_types, 2);
+    LLVMValueRef args[] = { channel, slot };
+    
+    LLVMValueRef status = LLVMBuildCall2(context->builder, LLVMGetElementType(LLVMTypeOf(next_func)), next_func,
+                                         args, 2, "next_status");
+    return LLVMBuildICmp(context->builder, LLVMIntNE, status, LLVMConstInt(LLVMInt32Type(), 0, false), "has_value");
+}
+
+static LLVMValueRef generate_spawn_body(Node* node, GeneratorContext* context, LLVMTypeRef env_type) {
+    LLVMTypeRef i8_ptr = LLVMPointerType(LLVMInt8Type(), 0);
+    LLVMTypeRef body_type = LLVMFunctionType(LLVMVoidType(), &i8_ptr, 1, false);
+    
+    LLVMValueRef body_func = LLVMAddFunction(context->module, "tf_spawn_body", body_type);
+    LLVMSetLinkage(body_func, LLVMInternalLinkage);
+    
+    StackSlots body_slots = { NULL, 0, 0 };
+    GeneratorContext body_context = *context;
+    body_context.function = body_func;
+    body_context.symbol_table = create_symbol_table();
+    body_context.parallel = true;
+    body_context.isolated_block = "spawn";
+    body_context.free_slots = &body_slots;
+    
+    if (context->di_builder != NULL) {
+        body_context.di_scope = create_debug_function(context, body_func, "tf_spawn_body", node->line);
+    }
+    
+    LLVMBasicBlockRef entry = LLVMAppendBasicBlock(body_func, "entry");
+    LLVMPositionBuilderAtEnd(context->builder, entry);
+    set_debug_location(&body_context, node->line);
+    
+    LLVMValueRef env = LLVMBuildBitCast(context->builder, LLVMGetParam(body_func, 0),
+                                        LLVMPointerType(env_type, 0), "env");
+    SymbolTable* outer = context->symbol_table;
+    
+    for (int k = 0; k < outer->symbol_count; k++) {
+        LLVMValueRef field = LLVMBuildStructGEP2(context->builder, env_type, env, k, outer->symbols[k].name);
+        push_symbol(body_context.symbol_table, outer->symbols[k].name, field, outer->symbols[k].type)->read_only = true;
+    }
+    
+    generate_node(node->data.spawn.body, &body_context);
+    LLVMBuildFree(context->builder, LLVMGetParam(body_func, 0));
+    LLVMBuildRetVoid(context->builder);
+    
+    free_symbol_table(body_context.symbol_table);
+    free(body_slots.allocas);
+    
+    return body_func;
+}
+
+static LLVMValueRef generate_spawn(Node* node, GeneratorContext* context) {
+    require_full_runtime(context, "spawn");
+    
+    LLVMTypeRef i8_ptr = LLVMPointerType(LLVMInt8Type(), 0);
+    SymbolTable* outer = context->symbol_table;
+    LLVMTypeRef field_types[outer->symbol_count > 0 ? outer->symbol_count : 1];
+    
+    for (int k = 0; k < outer->symbol_count; k++) {
+        field_types[k] = outer->symbols[k].type;
+    }
+    
+    LLVMTypeRef env_type = LLVMStructType(field_types, outer->symbol_count, false);
+    LLVMValueRef env = LLVMBuildMalloc(context->builder, env_type, "spawn_env");
+    
+    for (int k = 0; k < outer->symbol_count; k++) {
+        LLVMValueRef field = LLVMBuildStructGEP2(context->builder, env_type, env, k, "env_field");
+        LLVMValueRef value = LLVMBuildLoad2(context->builder, outer->symbols[k].type, outer->symbols[k].value,
+                                            outer->symbols[k].name);
+        LLVMBuildStore(context->builder, value, field);
+    }
+    
+    LLVMBasicBlockRef current_block = LLVMGetInsertBlock(context->builder);
+    LLVMValueRef body_func = generate_spawn_body(node, context, env_type);
+    LLVMPositionBuilderAtEnd(context->builder, current_block);
+    set_debug_location(context, node->line);
+    
+    LLVMTypeRef body_ptr_type = LLVMPointerType(LLVMFunctionType(LLVMVoidType(), &i8_ptr, 1, false), 0);
+    LLVMTypeRef param_types[] = { body_ptr_type, i8_ptr };
+    LLVMValueRef spawn_func = get_runtime_function(context, "tf_spawn", LLVMVoidType(), param_types, 2);
+    
+    LLVMValueRef args[] = { body_func, LLVMBuildBitCast(context->builder, env, i8_ptr, "env_arg") };
+    LLVMBuildCall2(context->builder, LLVMGetElementType(LLVMTypeOf(spawn_func)), spawn_func, args, 2, "");
+    
+    return NULL;
+}
+
+static LLVMValueRef generate_channel_decl(Node* node, GeneratorContext* context) {
+    require_full_runtime(context, "channel");
+    
+    LLVMTypeRef type = channel_type(node->data.channel_decl.data_type);
+    LLVMValueRef capacity = LLVMConstInt(LLVMInt32Type(), TF_CHANNEL_DEFAULT_CAPACITY, false);
+    
+    if (node->data.channel_decl.capacity != NULL) {
+        capacity = generate_expression(node->data.channel_decl.capacity, context);
+        if (LLVMTypeOf(capacity) != LLVMInt32Type()) {
+            codegen_error("Erro: Capacidade do canal '%s' deve ser i32", node->data.channel_decl.name);
+        }
+    }
+    
+    LLVMTypeRef param_types[] = { LLVMInt32Type() };
+    LLVMValueRef new_func = get_runtime_function(context, "tf_chan_new", LLVMPointerType(LLVMInt8Type(), 0),
+                                                 param_types, 1);
+    LLVMValueRef channel = LLVMBuildCall2(context->builder, LLVMGetElementType(LLVMTypeOf(new_func)), new_func,
+                                          &capacity, 1, "new_channel");
+    
+    Symbol* symbol = find_local_symbol(context->symbol_table, node->data.channel_decl.name);
+    if (symbol != NULL && symbol->slot) {
+        release_stack_slot(context, symbol);
+    }
+    
+    LLVMValueRef alloca = acquire_stack_slot(context, type, node->data.channel_decl.name);
+    symbol = add_symbol(context->symbol_table, node->data.channel_decl.name, alloca, type);
+    symbol->slot = true;
+    build_lifetime_marker(context, "llvm.lifetime.start", symbol);
+    
+    LLVMBuildStore(context->builder, LLVMBuildBitCast(context->builder, channel, type, "channel"), alloca);
+    return alloca;
+}
+
+static LLVMValueRef generate_send(Node* node, GeneratorContext* context) {
+    Symbol* symbol = lookup_channel(context, node->data.channel_op.channel);
+    LLVMValueRef value = generate_expression(node->data.channel_op.value, context);
+    
+    if (LLVMTypeOf(value) != variable_type(channel_element_type(symbol->type))) {
+        codegen_error("Erro: Tipo incompatível no envio para o canal '%s'", node->data.channel_op.channel);
+    }
+    
+    LLVMTypeRef param_types[] = { LLVMPointerType(LLVMInt8Type(), 0), LLVMInt64Type() };
+    LLVMValueRef send_func = get_runtime_function(context, "tf_chan_send", LLVMVoidType(), param_types, 2);
+    LLVMValueRef args[] = { load_channel(context, symbol), channel_word(context, value) };
+    return LLVMBuildCall2(context->builder, LLVMGetElementType(LLVMTypeOf(send_func)), send_func, args, 2, "");
+}
+
+static LLVMValueRef generate_receive(Node* node, GeneratorContext* context) {
+    Symbol* symbol = lookup_channel(context, node->data.channel_op.channel);
+    const char* element = channel_element_type(symbol->type);
+    LLVMTypeRef type = variable_type(element);
+    
+    LLVMValueRef slot = build_entry_alloca(context, LLVMInt64Type(), NULL, "received_word");
+    LLVMValueRef has_value = build_channel_next(context, load_channel(context, symbol), slot);
+    LLVMValueRef word = LLVMBuildLoad2(context->builder, LLVMInt64Type(), slot, "word");
+    LLVMValueRef zero = strcmp(element, "str") == 0 ? build_string_constant(context, "", "empty_str")
+                                                    : LLVMConstInt(type, 0, false);
+    
+    return LLVMBuildSelect(context->builder, has_value, channel_value(context, word, type), zero, "receive");
+}
+
+static LLVMValueRef generate_close(Node* node, GeneratorContext* context) {
+    Symbol* symbol = lookup_channel(context, node->data.channel_op.channel);
+    
+    LLVMTypeRef param_types[] = { LLVMPointerType(LLVMInt8Type(), 0) };
+    LLVMValueRef close_func = get_runtime_function(context, "tf_chan_close", LLVMVoidType(), param_types, 1);
+    LLVMValueRef args[] = { load_channel(context, symbol) };
+    return LLVMBuildCall2(context->builder, LLVMGetElementType(LLVMTypeOf(close_func)), close_func, args, 1, "");
+}
+
+static LLVMValueRef generate_receive_loop(Node* node, GeneratorContext* context) {
+    Symbol* symbol = lookup_channel(context, node->data.receive_loop.channel);
+    LLVMTypeRef type = variable_type(channel_element_type(symbol->type));
+    LLVMValueRef channel = load_channel(context, symbol);
+    LLVMValueRef slot = build_entry_alloca(context, LLVMInt64Type(), NULL, "received_word");
+    
+    LLVMBasicBlockRef cond_block = LLVMAppendBasicBlock(context->function, "receive_cond");
+    LLVMBasicBlockRef body_block = LLVMAppendBasicBlock(context->function, "receive_body");
+    LLVMBasicBlockRef end_block = LLVMAppendBasicBlock(context->function, "receive_end");
+    LLVMValueRef loop_counter = create_loop_counter(context, node, "stream");
+    
+    LLVMBuildBr(context->builder, cond_block);
+    
+    LLVMPositionBuilderAtEnd(context->builder, cond_block);
+    LLVMBuildCondBr(context->builder, build_channel_next(context, channel, slot), body_block, end_block);
+    
+    LLVMPositionBuilderAtEnd(context->builder, body_block);
+    count_loop_iterations(context, loop_counter, LLVMConstInt(LLVMInt64Type(), 1, false));
+    int scope = enter_scope(context);
+    
+    LLVMValueRef alloca = acquire_stack_slot(context, type, node->data.receive_loop.var_name);
+    Symbol* variable = add_symbol(context->symbol_table, node->data.receive_loop.var_name, alloca, type);
+    variable->slot = true;
+    build_lifetime_marker(context, "llvm.lifetime.start", variable);
+    
+    LLVMValueRef word = LLVMBuildLoad2(context->builder, LLVMInt64Type(), slot, "word");
+    LLVMBuildStore(context->builder, channel_value(context, word, type), alloca);
+    
+    generate_statements(node->data.receive_loop.body, context);
+    leave_scope(context, scope);
+    build_back_edge(context, cond_block);
+    
+    LLVMPositionBuilderAtEnd(context->builder, end_block);
+    
+    return NULL;
+}
+
+typedef struct {
+    char* name;
+    char* global;
+    LLVMTypeRef type;
+} ReplVariable;
+
+typedef struct {
+    ReplVariable* variables;
+    int count;
+    int capacity;
+} ReplVariables;
+
+typedef struct {
+    uint8_t* start;
+    size_t size;
+    size_t length;
+    bool code;
+    bool read_only;
+} ReplSection;
+
+typedef struct {
+    ReplSection* sections;
+    int count;
+    int capacity;
+} ReplSections;
+
+typedef struct {
+    LLVMValueRef function;
+    uintptr_t address;
+} ReplSymbol;
+
+struct ReplSession {
+    LLVMExecutionEngineRef engine;
+    char* triple;
+    ReplVariables variables;
+    ReplVariables pending;
+    int entry_count;
+    int global_count;
+    ReplSections sections;
+    FILE* perf_map;
+};
+
+static uint8_t* allocate_repl_section(ReplSession* session, uintptr_t size, bool code, bool read_only) {
+    long page_size = sysconf(_SC_PAGESIZE);
+    size_t length = ((size_t)size + page_size - 1) / page_size * page_size;
+    if (length == 0) length = page_size;
+    
+    void* start = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (start == MAP_FAILED) return NULL;
+    
+    ReplSections* sections = &session->sections;
+    if (sections->count == sections->capacity) {
+        int capacity = sections->capacity == 0 ? 16 : sections->capacity * 2;
+        ReplSection* grown = (ReplSection*)realloc(sections->sections, capacity * sizeof(ReplSection));
+        if (grown == NULL) {
+            munmap(start, length);
+            return NULL;
+        }
+        sections->sections = grown;
+        sections->capacity = capacity;
+    }
+    
+    ReplSection* section = &sections->sections[sections->count++];
+    section->start = (uint8_t*)start;
+    section->size = (size_t)size;
+    section->length = length;
+    section->code = code;
+    section->read_only = read_only;
+    return section->start;
+}
+
+static uint8_t* allocate_repl_code_section(void* opaque, uintptr_t size, unsigned alignment, unsigned section_id,
+                                           const char* section_name) {
+    (void)alignment;
+    (void)section_id;
+    (void)section_name;
+    return allocate_repl_section((ReplSession*)opaque, size, true, true);
+}
+
+static uint8_t* allocate_repl_data_section(void* opaque, uintptr_t size, unsigned alignment, unsigned section_id,
+                                           const char* section_name, LLVMBool is_read_only) {
+    (void)alignment;
+    (void)section_id;
+    (void)section_name;
+    return allocate_repl_section((ReplSession*)opaque, size, false, is_read_only);
+}
+
+static LLVMBool finalize_repl_sections(void* opaque, char** error) {
+    ReplSession* session = (ReplSession*)opaque;
+    for (int i = 0; i < session->sections.count; i++) {
+        ReplSection* section = &session->sections.sections[i];
+        if (!section->read_only) continue;
+        
+        int protection = section->code ? PROT_READ | PROT_EXEC : PROT_READ;
+        if (mprotect(section->start, section->length, protection) != 0) {
+            *error = strdup("não foi possível proteger o código gerado");
+            return 1;
+        }
+        if (section->code) {
+            __builtin___clear_cache((char*)section->start, (char*)section->start + section->size);
+        }
+    }
+    return 0;
+}
+
+static void destroy_repl_sections(void* opaque) {
+    ReplSession* session = (ReplSession*)opaque;
+    for (int i = 0; i < session->sections.count; i++) {
+        munmap(session->sections.sections[i].start, session->sections.sections[i].length);
+    }
+    free(session->sections.sections);
+    session->sections.sections = NULL;
+    session->sections.count = 0;
+    session->sections.capacity = 0;
+}
+
+static int compare_repl_symbols(const void* a, const void* b) {
+    uintptr_t left = ((const ReplSymbol*)a)->address;
+    uintptr_t right = ((const ReplSymbol*)b)->address;
+    return left < right ? -1 : left > right;
+}
+
+static uintptr_t repl_code_end(ReplSession* session, int first_section, uintptr_t address) {
+    for (int i = first_section; i < session->sections.count; i++) {
+        ReplSection* section = &session->sections.sections[i];
+        uintptr_t start = (uintptr_t)section->start;
+        if (section->code && address >= start && address < start + section->size) {
+            return start + section->size;
+        }
+    }
+    return 0;
+}
+
+static void write_perf_map(ReplSession* session, LLVMModuleRef module, int first_section) {
+    int count = 0;
+    for (LLVMValueRef function = LLVMGetFirstFunction(module); function != NULL;
+         function = LLVMGetNextFunction(function)) {
+        if (!LLVMIsDeclaration(function)) count++;
+    }
+    if (count == 0) return;
+    
+    ReplSymbol* symbols = (ReplSymbol*)malloc(count * sizeof(ReplSymbol));
+    if (symbols == NULL) return;
+    
+    int found = 0;
+    for (LLVMValueRef function = LLVMGetFirstFunction(module); function != NULL;
+         function = LLVMGetNextFunction(function)) {
+        if (LLVMIsDeclaration(function)) continue;
+        
+        uintptr_t address = (uintptr_t)LLVMGetFunctionAddress(session->engine, LLVMGetValueName(function));
+        if (address == 0 || repl_code_end(session, first_section, address) == 0) continue;
+        symbols[found].function = function;
+        symbols[found].address = address;
+        found++;
+    }
+    qsort(symbols, found, sizeof(ReplSymbol), compare_repl_symbols);
+    
+    for (int i = 0; i < found; i++) {
+        uintptr_t end = repl_code_end(session, first_section, symbols[i].address);
+        if (i + 1 < found && symbols[i + 1].address < end) end = symbols[i + 1].address;
+        if (end <= symbols[i].address) continue;
+        
+        fprintf(session->perf_map, "%lx %lx %s\n", (unsigned long)symbols[i].address,
+                (unsigned long)(end - symbols[i].address), LLVMGetValueName(symbols[i].function));
+    }
+    fflush(session->perf_map);
+    free(symbols);
+}
+
+static void set_repl_variable(ReplVariables* list, const char* name, const char* global, LLVMTypeRef type) {
+    for (int i = 0; i < list->count; i++) {
+        if (strcmp(list->variables[i].name, name) == 0) {
+            free(list->variables[i].global);
+            list->variables[i].global = strdup(global);
+            list->variables[i].type = type;
+            return;
+        }
+    }
+    
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity == 0 ? 16 : list->capacity * 2;
+        list->variables = (ReplVariable*)realloc(list->variables, list->capacity * sizeof(ReplVariable));
+        if (list->variables == NULL) {
+            codegen_error("Erro: Falha na alocação de memória para as variáveis da sessão");
+        }
+    }
+    
+    ReplVariable* variable = &list->variables[list->count++];
+    variable->name = strdup(name);
+    variable->global = strdup(global);
+    variable->type = type;
+}
+
+static void clear_repl_variables(ReplVariables* list) {
+    for (int i = 0; i < list->count; i++) {
+        free(list->variables[i].name);
+        free(list->variables[i].global);
+    }
+    list->count = 0;
+}
+
+static bool is_repl_expression(const Node* node) {
+    switch (node->type) {
+        case NODE_BINARY_OP:
+        case NODE_UNARY_OP:
+        case NODE_INT_VAL:
+        case NODE_STRING_VAL:
+        case NODE_BOOL_VAL:
+        case NODE_IDENTIFIER:
+        case NODE_READ:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void generate_repl_variable(Node* node, GeneratorContext* context, ReplSession* session) {
+    const char* name = node->data.var_decl.name;
+    LLVMTypeRef type = variable_type(node->data.var_decl.data_type);
+    LLVMValueRef value = node->data.var_decl.init_expr != NULL
+        ? generate_expression(node->data.var_decl.init_expr, context)
+        : default_value(context, node->data.var_decl.data_type);
+    
+    char global_name[strlen(name) + 16];
+    snprintf(global_name, sizeof(global_name), "%s.%d", name, session->global_count++);
+    
+    LLVMValueRef global = LLVMAddGlobal(context->module, type, global_name);
+    LLVMSetInitializer(global, LLVMConstNull(type));
+    LLVMBuildStore(context->builder, value, global);
+    
+    add_symbol(context->symbol_table, name, global, type);
+    set_repl_variable(&session->pending, name, global_name, type);
+}
+
+static void generate_repl_entry(Node* statements, GeneratorContext* context, ReplSession* session) {
+    for (int i = 0; i < session->variables.count; i++) {
+        ReplVariable* variable = &session->variables.variables[i];
+        LLVMValueRef global = LLVMAddGlobal(context->module, variable->type, variable->global);
+        push_symbol(context->symbol_table, variable->name, global, variable->type);
+    }
+    
+    for (int i = 0; i < statements->data.block.stmt_count; i++) {
+        Node* statement = statements->data.block.statements[i];
+        
+        if (statement->type == NODE_VAR_DECL) {
+            generate_repl_variable(statement, context, session);
+        } else if (is_repl_expression(statement)) {
+            Node print = { .type = NODE_PRINT, .line = statement->line };
+            print.data.print_stmt.expr = statement;
+            generate_node(&print, context);
         } else {
-            format = "%d\n";
+            generate_node(statement, context);
         }
+    }
+    
+    if (LLVMGetNamedFunction(context->module, "tf_spawn") != NULL) {
+        LLVMValueRef wait_func = get_runtime_function(context, "tf_spawn_wait", LLVMVoidType(), NULL, 0);
+        LLVMBuildCall2(context->builder, LLVMGetElementType(LLVMTypeOf(wait_func)), wait_func, NULL, 0, "");
+    }
+    
+    LLVMBuildRetVoid(context->builder);
+}
+
+ReplSession* create_repl_session(char* error, size_t error_size) {
+    initialize_llvm_backend();
+    LLVMLinkInMCJIT();
+    
+    if (LLVMLoadLibraryPermanently(NULL) != 0) {
+        snprintf(error, error_size, "Erro: não foi possível expor o runtime ao compilador JIT");
+        return NULL;
+    }
+    
+    ReplSession* session = (ReplSession*)calloc(1, sizeof(ReplSession));
+    if (session == NULL) {
+        snprintf(error, error_size, "Erro: Falha na alocação de memória para a sessão");
+        return NULL;
+    }
+    
+    struct LLVMMCJITCompilerOptions jit_options;
+    LLVMInitializeMCJITCompilerOptions(&jit_options, sizeof(jit_options));
+    jit_options.OptLevel = 2;
+    
+    const char* perf_map = getenv("TECHFLOW_PERF_MAP");
+    if (perf_map != NULL && perf_map[0] != '\0' && strcmp(perf_map, "0") != 0) {
+        char path[64];
+        snprintf(path, sizeof(path), "/tmp/perf-%d.map", (int)getpid());
+        session->perf_map = fopen(path, "a");
+        if (session->perf_map == NULL) {
+            snprintf(error, error_size, "Erro: não foi possível criar o mapa de símbolos %s", path);
+            free(session);
+            return NULL;
+        }
+        jit_options.MCJMM = LLVMCreateSimpleMCJITMemoryManager(session, allocate_repl_code_section,
+                                                               allocate_repl_data_section, finalize_repl_sections,
+                                                               destroy_repl_sections);
+    }
+    
+    char* message = NULL;
+    LLVMModuleRef module = LLVMModuleCreateWithName("tf_repl");
+    if (LLVMCreateMCJITCompilerForModule(&session->engine, module, &jit_options, sizeof(jit_options),
+                                         &message) != 0) {
+        snprintf(error, error_size, "Erro: não foi possível criar o compilador JIT: %s", message);
+        LLVMDisposeMessage(message);
+        if (session->perf_map != NULL) fclose(session->perf_map);
+        free(session);
+        return NULL;
+    }
+    
+    session->triple = LLVMGetDefaultTargetTriple();
+    return session;
+}
+
+int execute_repl_statements(ReplSession* session, Node* statements) {
+    char function_name[32];
+    snprintf(function_name, sizeof(function_name), "tf_repl.%d", session->entry_count++);
+    
+    GeneratorContext context;
+    context.module = LLVMModuleCreateWithName(function_name);
+    LLVMSetTarget(context.module, session->triple);
+    LLVMSetModuleDataLayout(context.module, LLVMGetExecutionEngineTargetData(session->engine));
+    context.builder = LLVMCreateBuilder();
+    context.symbol_table = create_symbol_table();
+    context.di_builder = NULL;
+    context.di_file = NULL;
+    context.di_scope = NULL;
+    context.profile = NULL;
+    context.budget = false;
+    context.instrument = NULL;
+    context.parallel = false;
+    context.isolated_block = NULL;
+    context.minimal_runtime = false;
+    context.alloca_builder = LLVMCreateBuilder();
+    
+    StackSlots entry_slots = { NULL, 0, 0 };
+    context.free_slots = &entry_slots;
+    
+    LLVMTypeRef entry_type = LLVMFunctionType(LLVMVoidType(), NULL, 0, false);
+    context.function = LLVMAddFunction(context.module, function_name, entry_type);
+    LLVMPositionBuilderAtEnd(context.builder, LLVMAppendBasicBlock(context.function, "entry"));
+    
+    int status = 0;
+    jmp_buf recovery;
+    
+    if (setjmp(recovery) == 0) {
+        codegen_recovery = &recovery;
+        generate_repl_entry(statements, &context, session);
     } else {
-        format = "%s\n";
+        status = 1;
     }
+    codegen_recovery = NULL;
     
-    LLVMValueRef format_str = LLVMBuildGlobalStringPtr(context->builder, format, "format");
+    char* message = NULL;
+    if (status == 0 && LLVMVerifyModule(context.module, LLVMReturnStatusAction, &message) != 0) {
+        fprintf(stderr, "Erro: código inválido gerado para a entrada: %s\n", message);
+        status = 1;
+    }
+    LLVMDisposeMessage(message);
+    
+    free_symbol_table(context.symbol_table);
+    free(entry_slots.allocas);
+    LLVMDisposeBuilder(context.alloca_builder);
+    LLVMDisposeBuilder(context.builder);
+    
+    if (status != 0) {
+        clear_repl_variables(&session->pending);
+        LLVMDisposeModule(context.module);
+        return status;
+    }
+    
+    LLVMPassManagerRef pass_manager = LLVMCreatePassManager();
+    LLVMAddPromoteMemoryToRegisterPass(pass_manager);
+    LLVMAddInstructionCombiningPass(pass_manager);
+    LLVMAddReassociatePass(pass_manager);
+    LLVMAddGVNPass(pass_manager);
+    LLVMAddCFGSimplificationPass(pass_manager);
+    LLVMRunPassManager(pass_manager, context.module);
+    LLVMDisposePassManager(pass_manager);
+    
+    int first_section = session->sections.count;
+    LLVMAddModule(session->engine, context.module);
+    void (*entry)(void) = (void (*)(void))(uintptr_t)LLVMGetFunctionAddress(session->engine, function_name);
+    if (session->perf_map != NULL) write_perf_map(session, context.module, first_section);
+    
+    for (int i = 0; i < session->pending.count; i++) {
+        ReplVariable* variable = &session->pending.variables[i];
+        set_repl_variable(&session->variables, variable->name, variable->global, variable->type);
+    }
+    clear_repl_variables(&session->pending);
+    
+    entry();
+    return 0;
+}
 
-    LLVMTypeRef func_type = LLVMGetElementType(LLVMTypeOf(printf_func));
-    LLVMValueRef args[] = { format_str, expr };
-    return LLVMBuildCall2(context->builder, func_type, printf_func, args, 2, "printf_result");
+void free_repl_session(ReplSession* session) {
+    if (session == NULL) return;
+    
+    LLVMDisposeExecutionEngine(session->engine);
+    if (session->perf_map != NULL) fclose(session->perf_map);
+    clear_repl_variables(&session->variables);
+    clear_repl_variables(&session->pending);
+    free(session->variables.variables);
+    free(session->pending.variables);
+    LLVMDisposeMessage(session->triple);
+    free(session);
 }
\ No newline at end of file
@@ -1,7 +1,9 @@
 #ifndef LLVM_GENERATOR_H
 #define LLVM_GENERATOR_H
 
+#include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 typedef enum {
     NODE_PROGRAM,
@@ -19,11 +21,20 @@ typedef enum {
     NODE_INT_VAL,
     NODE_STRING_VAL,
     NODE_BOOL_VAL,
-    NODE_IDENTIFIER
+    NODE_IDENTIFIER,
+    NODE_READ,
+    NODE_PARALLEL_FOR,
+    NODE_SPAWN,
+    NODE_CHANNEL_DECL,
+    NODE_SEND,
+    NODE_RECEIVE,
+    NODE_CLOSE,
+    NODE_RECEIVE_LOOP
 } NodeType;
 
 typedef struct Node {
     NodeType type;
+    int line;
     union {
         int int_value;
         char* str_value;
@@ -59,9 +70,38 @@ typedef struct Node {
             struct Node* body;
             struct Node* condition;
         } repeat_stmt;
+        struct {
+            char* var_name;
+            struct Node* start;
+            struct Node* end;
+            struct Node* body;
+            char** reduce_ops;
+            char** reduce_vars;
+            int reduce_count;
+        } parallel_for;
+        struct {
+            struct Node* body;
+        } spawn;
+        struct {
+            char* name;
+            char* data_type;
+            struct Node* capacity;
+        } channel_decl;
+        struct {
+            char* channel;
+            struct Node* value;
+        } channel_op;
+        struct {
+            char* var_name;
+            char* channel;
+            struct Node* body;
+        } receive_loop;
         struct {
             struct Node* expr;
         } print_stmt;
+        struct {
+            char* data_type;
+        } read_expr;
         struct {
             struct Node* condition;
             struct Node** cases;
@@ -83,6 +123,45 @@ typedef struct Node {
     struct Node* next;
 } Node;
 
-void generate_llvm_code(Node* ast_root, const char* output_file);
+typedef struct Profile Profile;
+
+typedef struct {
+    uint64_t max_steps;
+    uint64_t max_ms;
+    uint64_t max_mem;
+} ExecutionLimits;
+
+typedef struct {
+    double generate_ms;
+    double verify_ms;
+    double optimize_ms;
+    double write_ms;
+    double dump_ms;
+    double partial_eval_ms;
+} CodegenTimings;
+
+typedef struct {
+    const char* source_file;
+    bool debug_info;
+    const Profile* profile;
+    ExecutionLimits limits;
+    CodegenTimings* timings;
+    bool instrument;
+    const char* target_triple;
+    const char* cpu;
+    const char* features;
+    uint64_t partial_eval_steps;
+    bool minimal_runtime;
+} CodegenOptions;
+
+void initialize_llvm_backend(void);
+void warm_target_machine(const CodegenOptions* options);
+int generate_llvm_code(Node* ast_root, const char* output_file, const CodegenOptions* options);
+
+typedef struct ReplSession ReplSession;
+
+ReplSession* create_repl_session(char* error, size_t error_size);
+int execute_repl_statements(ReplSession* session, Node* statements);
+void free_repl_session(ReplSession* session);
 
 #endif
\ No newline at end of file
@@ -2,41 +2,352 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include "llvm_generator.h"
+#include "llvm_backend.h"
+#include "interpreter.h"
+#include "program_image.h"
+#include "compile_server.h"
+#include "repl.h"
+#include "runtime_support.h"
+#include "mem_stats.h"
 
-extern int yyparse();
-extern FILE* yyin;
-extern struct Node* ast_root;
+#define PARTIAL_EVAL_DEFAULT_STEPS 1000000
 
-void execute_ast(struct Node* node);
+typedef enum {
+    MODE_INTERPRET,
+    MODE_COMPILE,
+    MODE_PRECOMPILE
+} ProgramMode;
+
+typedef struct {
+    ProgramMode mode;
+    const char* input_file;
+    const char* output_file;
+    const char* emit_profile;
+    const char* use_profile;
+    ExecutionLimits limits;
+    const char* checkpoint_file;
+    uint64_t checkpoint_every;
+    bool resume;
+    bool time_phases;
+    CodegenOptions codegen;
+} CommandOptions;
+
+struct Node* parse_program(FILE* input, char* error, size_t error_size);
+void free_ast(struct Node* node);
 
 void print_usage(const char* program_name) {
     printf("Uso: %s <arquivo.tf> [opções]\n", program_name);
+    printf("       %s --serve[=<socket>]\n", program_name);
+    printf("       %s --repl\n", program_name);
     printf("Opções:\n");
     printf("  --interpret    Interpretar o programa (padrão)\n");
     printf("  --compile      Compilar o programa para LLVM IR\n");
+    printf("  --precompile   Gerar programa pré-compilado (.tfc) para o interpretador\n");
     printf("  --output=<arquivo>  Especificar arquivo de saída para compilação\n");
+    printf("  -g             Incluir informações de depuração (DWARF) no LLVM IR\n");
+    printf("  --instrument   Incluir contadores de laços, log e alocações no programa compilado\n");
+    printf("  --target=<triple>   Gerar código para outro alvo (padrão: o do host)\n");
+    printf("  --mcpu=<cpu>        CPU alvo, ou 'native' para a CPU do host (padrão: generic)\n");
+    printf("  --mattr=<+a,-b>     Habilitar ou desabilitar recursos da CPU alvo\n");
+    printf("  --runtime=minimal   Gerar código para o runtime mínimo (binários estáticos, sem libc)\n");
+    printf("  --partial-eval[=<n>]  Pré-calcular na compilação o trecho inicial que não lê a entrada\n");
+    printf("  --emit-profile=<arquivo>  Interpretar e gravar os contadores de desvios\n");
+    printf("  --use-profile=<arquivo>   Usar o perfil gravado como pesos de desvio na compilação\n");
+    printf("  --serve[=<socket>]  Iniciar servidor de compilação persistente\n");
+    printf("  --client[=<socket>] Enviar a requisição para o servidor de compilação\n");
+    printf("  --repl         Sessão interativa: cada instrução é compilada (JIT) e executada ao ser digitada\n");
+    printf("  --mem-stats    Exibir estatísticas de alocação de memória ao final\n");
+    printf("  --max-steps=<n>     Limitar o número de iterações de laços\n");
+    printf("  --max-ms=<n>        Limitar o tempo de execução em milissegundos\n");
+    printf("  --max-mem=<n>[K|M|G]  Limitar a memória alocada pelo programa\n");
+    printf("  --checkpoint-every=<n>  Gravar o estado da execução a cada n iterações de laços\n");
+    printf("  --checkpoint-file=<arquivo>  Arquivo do checkpoint (padrão: <arquivo.tf>.ckpt)\n");
+    printf("  --resume       Retomar a execução a partir do checkpoint gravado\n");
+    printf("  --time-phases  Exibir o tempo gasto em cada fase ao final\n");
 }
 
-int main(int argc, char* argv[]) {
-    if (argc < 2) {
-        print_usage(argv[0]);
+static void report_mem_stats(void) {
+    tf_mem_stats_report(stderr);
+}
+
+static void report_phase(const char* name, double ms) {
+    int width = 0;
+    for (const char* c = name; *c != '\0'; c++) {
+        if ((*c & 0xC0) != 0x80) width++;
+    }
+    fprintf(stderr, "  %s%*s %10.3f ms\n", name, width < 20 ? 20 - width : 0, "", ms);
+}
+
+static bool parse_limit(const char* text, bool allow_suffix, uint64_t* value) {
+    char* end;
+    unsigned long long parsed = strtoull(text, &end, 10);
+    
+    if (end == text || text[0] == '-') return false;
+    
+    int shift = 0;
+    if (allow_suffix && *end != '\0' && end[1] == '\0') {
+        switch (*end) {
+            case 'K': case 'k': shift = 10; end++; break;
+            case 'M': case 'm': shift = 20; end++; break;
+            case 'G': case 'g': shift = 30; end++; break;
+        }
+    }
+    
+    if (*end != '\0' || parsed == 0 || parsed > (unsigned long long)(INT64_MAX >> shift)) return false;
+    parsed <<= shift;
+    
+    *value = parsed;
+    return true;
+}
+
+static int run_interpreter(struct Node* ast_root, const CommandOptions* options) {
+    InterpreterOptions interpreter_options = { NULL };
+    interpreter_options.limits = options->limits;
+    interpreter_options.checkpoint_file = options->checkpoint_file;
+    interpreter_options.checkpoint_every = options->checkpoint_every;
+    interpreter_options.resume = options->resume;
+    
+    if (options->emit_profile != NULL) {
+        interpreter_options.profile = create_profile(ast_root);
+    }
+    
+    if (options->resume) {
+        printf("Retomando execução a partir de %s...\n", options->checkpoint_file);
+    } else {
+        printf("Executando programa...\n");
+    }
+    char run_error[256];
+    double start = tf_monotonic_ms();
+    int status = interpret_program(ast_root, stdin, stdout, &interpreter_options, run_error, sizeof(run_error));
+    
+    if (options->time_phases) {
+        report_phase("execução", tf_monotonic_ms() - start);
+    }
+    
+    if (status != 0) {
+        fflush(stdout);
+        fprintf(stderr, "%s\n", run_error);
+        free_profile(interpreter_options.profile);
         return 1;
     }
+    printf("Execução concluída.\n");
+    
+    if (interpreter_options.profile != NULL) {
+        char profile_error[256];
+        int status = write_profile(interpreter_options.profile, options->emit_profile,
+                                   profile_error, sizeof(profile_error));
+        free_profile(interpreter_options.profile);
+        
+        if (status != 0) {
+            fprintf(stderr, "%s\n", profile_error);
+            return 1;
+        }
+        printf("Perfil gravado em %s\n", options->emit_profile);
+    }
+    return 0;
+}
+
+static int run_compiler(struct Node* ast_root, const CommandOptions* options) {
+    CodegenOptions codegen_options = options->codegen;
+    Profile* profile = NULL;
+    
+    if (options->use_profile != NULL) {
+        char profile_error[256];
+        profile = load_profile(ast_root, options->use_profile, profile_error, sizeof(profile_error));
+        if (profile == NULL) {
+            fprintf(stderr, "%s\n", profile_error);
+            return 1;
+        }
+        codegen_options.profile = profile;
+    }
+    
+    CodegenTimings timings = { 0 };
+    if (options->time_phases) {
+        codegen_options.timings = &timings;
+    }
+    
+    char backend_error[256];
+    const LLVMBackend* backend = load_llvm_backend(backend_error, sizeof(backend_error));
+    if (backend == NULL) {
+        fprintf(stderr, "%s\n", backend_error);
+        free_profile(profile);
+        return 1;
+    }
+    
+    printf("Compilando programa para LLVM IR (%s)...\n", options->output_file);
+    if (backend->generate_llvm_code(ast_root, options->output_file, &codegen_options) != 0) {
+        free_profile(profile);
+        return 1;
+    }
+    printf("Compilação concluída.\n");
+    
+    if (options->time_phases) {
+        if (codegen_options.partial_eval_steps > 0) {
+            report_phase("avaliação parcial", timings.partial_eval_ms);
+        }
+        report_phase("geração de IR", timings.generate_ms);
+        report_phase("verificação", timings.verify_ms);
+        report_phase("otimização", timings.optimize_ms);
+        report_phase("escrita do bitcode", timings.write_ms);
+        report_phase("impressão do IR", timings.dump_ms);
+    }
+    
+    printf("\nPara compilar para um executável:\n");
+    printf("clang %s -o programa\n", options->output_file);
+    printf("./programa\n");
+    
+    free_profile(profile);
+    return 0;
+}
+
+static int process_program(const CommandOptions* options) {
+    const char* input_file = options->input_file;
+    ProgramImage image = { NULL, 0 };
+    struct Node* ast_root;
+    int status = 0;
+    
+    double start = tf_monotonic_ms();
+    
+    if (options->time_phases) {
+        fprintf(stderr, "Tempos por fase:\n");
+    }
+    
+    if (is_program_image(input_file)) {
+        char load_error[256];
+        ast_root = load_program_image(input_file, &image, load_error, sizeof(load_error));
+        
+        if (ast_root == NULL) {
+            fprintf(stderr, "%s\n", load_error);
+            return 1;
+        }
+    } else {
+        FILE* file = fopen(input_file, "r");
+        if (!file) {
+            fprintf(stderr, "Erro: não foi possível abrir o arquivo '%s'\n", input_file);
+            return 1;
+        }
+        
+        printf("Iniciando análise sintática...\n");
+        char parse_error[256];
+        ast_root = parse_program(file, parse_error, sizeof(parse_error));
+        
+        fclose(file);
+        
+        if (ast_root == NULL) {
+            fprintf(stderr, "%s\n", parse_error);
+            fprintf(stderr, "Erro durante a análise sintática\n");
+            return 1;
+        }
+        
+        printf("Análise sintática concluída com sucesso!\n");
+    }
+    
+    if (options->time_phases) {
+        report_phase(image.data != NULL ? "carga da imagem" : "análise sintática", tf_monotonic_ms() - start);
+    }
     
-    char* input_file = NULL;
-    char* output_file = "output.bc";
-    bool do_compile = false;
+    if (options->mode == MODE_PRECOMPILE) {
+        char write_error[256];
+        printf("Gerando programa pré-compilado (%s)...\n", options->output_file);
+        if (write_program_image(ast_root, options->output_file, write_error, sizeof(write_error)) != 0) {
+            fprintf(stderr, "%s\n", write_error);
+            status = 1;
+        } else {
+            printf("Pré-compilação concluída.\n");
+        }
+    } else if (options->mode == MODE_COMPILE) {
+        status = run_compiler(ast_root, options);
+    } else {
+        status = run_interpreter(ast_root, options);
+    }
+    
+    if (image.data != NULL) {
+        unload_program_image(&image);
+    } else {
+        free_ast(ast_root);
+    }
+    return status;
+}
+
+int run_command(int argc, char* argv[]) {
+    CommandOptions options;
+    memset(&options, 0, sizeof(options));
+    options.mode = MODE_INTERPRET;
+    bool mem_stats = false;
     
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "--interpret") == 0) {
-            do_compile = false;
+            options.mode = MODE_INTERPRET;
         } else if (strcmp(argv[i], "--compile") == 0) {
-            do_compile = true;
+            options.mode = MODE_COMPILE;
+        } else if (strcmp(argv[i], "--precompile") == 0) {
+            options.mode = MODE_PRECOMPILE;
         } else if (strncmp(argv[i], "--output=", 9) == 0) {
-            output_file = argv[i] + 9;
+            options.output_file = argv[i] + 9;
+        } else if (strcmp(argv[i], "-g") == 0) {
+            options.codegen.debug_info = true;
+        } else if (strncmp(argv[i], "--emit-profile=", 15) == 0) {
+            options.emit_profile = argv[i] + 15;
+        } else if (strncmp(argv[i], "--use-profile=", 14) == 0) {
+            options.use_profile = argv[i] + 14;
+        } else if (strcmp(argv[i], "--mem-stats") == 0) {
+            mem_stats = true;
+        } else if (strncmp(argv[i], "--target=", 9) == 0) {
+            options.codegen.target_triple = argv[i] + 9;
+        } else if (strncmp(argv[i], "--mcpu=", 7) == 0) {
+            options.codegen.cpu = argv[i] + 7;
+        } else if (strncmp(argv[i], "--mattr=", 8) == 0) {
+            options.codegen.features = argv[i] + 8;
+        } else if (strcmp(argv[i], "--instrument") == 0) {
+            options.codegen.instrument = true;
+        } else if (strncmp(argv[i], "--runtime=", 10) == 0) {
+            if (strcmp(argv[i] + 10, "minimal") == 0) {
+                options.codegen.minimal_runtime = true;
+            } else if (strcmp(argv[i] + 10, "default") == 0) {
+                options.codegen.minimal_runtime = false;
+            } else {
+                printf("Erro: runtime desconhecido: %s (use 'default' ou 'minimal')\n", argv[i] + 10);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--partial-eval") == 0) {
+            options.codegen.partial_eval_steps = PARTIAL_EVAL_DEFAULT_STEPS;
+        } else if (strncmp(argv[i], "--partial-eval=", 15) == 0) {
+            if (!parse_limit(argv[i] + 15, false, &options.codegen.partial_eval_steps)) {
+                printf("Erro: valor inválido para --partial-eval: %s\n", argv[i] + 15);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--time-phases") == 0) {
+            options.time_phases = true;
+        } else if (strncmp(argv[i], "--max-steps=", 12) == 0) {
+            if (!parse_limit(argv[i] + 12, false, &options.limits.max_steps)) {
+                printf("Erro: valor inválido para --max-steps: %s\n", argv[i] + 12);
+                return 1;
+            }
+        } else if (strncmp(argv[i], "--max-ms=", 9) == 0) {
+            if (!parse_limit(argv[i] + 9, false, &options.limits.max_ms)) {
+                printf("Erro: valor inválido para --max-ms: %s\n", argv[i] + 9);
+                return 1;
+            }
+        } else if (strncmp(argv[i], "--max-mem=", 10) == 0) {
+            if (!parse_limit(argv[i] + 10, true, &options.limits.max_mem)) {
+                printf("Erro: valor inválido para --max-mem: %s\n", argv[i] + 10);
+                return 1;
+            }
+        } else if (strncmp(argv[i], "--checkpoint-every=", 19) == 0) {
+            if (!parse_limit(argv[i] + 19, false, &options.checkpoint_every)) {
+                printf("Erro: valor inválido para --checkpoint-every: %s\n", argv[i] + 19);
+                return 1;
+            }
+        } else if (strncmp(argv[i], "--checkpoint-file=", 18) == 0) {
+            options.checkpoint_file = argv[i] + 18;
+        } else if (strcmp(argv[i], "--resume") == 0) {
+            options.resume = true;
+        } else if (strcmp(argv[i], "--client") == 0 || strncmp(argv[i], "--client=", 9) == 0) {
+            continue;
         } else if (argv[i][0] != '-') {
-            input_file = argv[i];
+            options.input_file = argv[i];
         } else {
             printf("Opção desconhecida: %s\n", argv[i]);
             print_usage(argv[0]);
@@ -44,50 +355,116 @@ int main(int argc, char* argv[]) {
         }
     }
     
-    if (!input_file) {
+    if (!options.input_file) {
         printf("Erro: Nenhum arquivo de entrada especificado\n");
         print_usage(argv[0]);
         return 1;
     }
     
-    FILE* file = fopen(input_file, "r");
-    if (!file) {
-        fprintf(stderr, "Erro: não foi possível abrir o arquivo '%s'\n", input_file);
+    if (options.output_file == NULL) {
+        options.output_file = options.mode == MODE_PRECOMPILE ? "output.tfc" : "output.bc";
+    }
+    
+    if (options.emit_profile != NULL && options.mode != MODE_INTERPRET) {
+        printf("Erro: --emit-profile só pode ser usado na interpretação\n");
         return 1;
     }
     
-    yyin = file;
+    if (options.use_profile != NULL && options.mode != MODE_COMPILE) {
+        printf("Erro: --use-profile só pode ser usado com --compile\n");
+        return 1;
+    }
     
-    printf("Iniciando análise sintática...\n");
-    int parse_result = yyparse();
+    if ((options.codegen.target_triple != NULL || options.codegen.cpu != NULL || options.codegen.features != NULL) &&
+        options.mode != MODE_COMPILE) {
+        printf("Erro: --target, --mcpu e --mattr só podem ser usados com --compile\n");
+        return 1;
+    }
     
-    fclose(file);
+    if (options.codegen.instrument && options.mode != MODE_COMPILE) {
+        printf("Erro: --instrument só pode ser usado com --compile\n");
+        return 1;
+    }
     
-    if (parse_result == 0) {
-        printf("Análise sintática concluída com sucesso!\n");
-        
-        if (ast_root != NULL) {
-            if (do_compile) {
-                printf("Compilando programa para LLVM IR (%s)...\n", output_file);
-                generate_llvm_code(ast_root, output_file);
-                printf("Compilação concluída.\n");
-                
-                printf("\nPara compilar para um executável:\n");
-                printf("clang %s -o programa\n", output_file);
-                printf("./programa\n");
-            } else {
-                printf("Executando programa...\n");
-                execute_ast(ast_root);
-                printf("Execução concluída.\n");
-            }
-        } else {
-            fprintf(stderr, "Erro: AST vazia\n");
-            return 1;
-        }
-    } else {
-        fprintf(stderr, "Erro durante a análise sintática\n");
+    if (options.codegen.minimal_runtime && options.mode != MODE_COMPILE) {
+        printf("Erro: --runtime só pode ser usado com --compile\n");
         return 1;
     }
     
-    return 0;
-}
\ No newline at end of file
+    if (options.codegen.minimal_runtime && options.codegen.instrument) {
+        printf("Erro: --instrument não pode ser usado com --runtime=minimal\n");
+        return 1;
+    }
+    
+    if (options.codegen.partial_eval_steps > 0 && options.mode != MODE_COMPILE) {
+        printf("Erro: --partial-eval só pode ser usado com --compile\n");
+        return 1;
+    }
+    
+    if ((options.checkpoint_every > 0 || options.resume || options.checkpoint_file != NULL) &&
+        options.mode != MODE_INTERPRET) {
+        printf("Erro: --checkpoint-every, --checkpoint-file e --resume só podem ser usados na interpretação\n");
+        return 1;
+    }
+    
+    char checkpoint_file[4096];
+    if (options.checkpoint_file == NULL) {
+        snprintf(checkpoint_file, sizeof(checkpoint_file), "%s.ckpt", options.input_file);
+        options.checkpoint_file = checkpoint_file;
+    }
+    
+    if (mem_stats) {
+        tf_mem_stats_enable();
+        atexit(report_mem_stats);
+    }
+    
+    options.codegen.source_file = options.input_file;
+    options.codegen.limits = options.limits;
+    return process_program(&options);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    
+    bool serve = false;
+    bool repl = false;
+    bool use_server = false;
+    const char* socket_path = NULL;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--serve") == 0) {
+            serve = true;
+        } else if (strncmp(argv[i], "--serve=", 8) == 0) {
+            serve = true;
+            socket_path = argv[i] + 8;
+        } else if (strcmp(argv[i], "--repl") == 0) {
+            repl = true;
+        } else if (strcmp(argv[i], "--client") == 0) {
+            use_server = true;
+        } else if (strncmp(argv[i], "--client=", 9) == 0) {
+            use_server = true;
+            socket_path = argv[i] + 9;
+        }
+    }
+    
+    if (socket_path == NULL) {
+        socket_path = default_server_socket();
+    }
+    
+    if (serve) {
+        return run_compile_server(socket_path);
+    }
+    
+    if (repl) {
+        return run_repl();
+    }
+    
+    if (use_server) {
+        return run_compile_client(socket_path, argc, argv);
+    }
+    
+    return run_command(argc, argv);
+}
@@ -0,0 +1,250 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "mem_stats.h"
+
+#define MEM_SITE_CAPACITY 1024
+#define MEM_TOP_SITES 10
+
+struct TFMemAccount {
+    int64_t live_bytes;
+    int64_t references;
+};
+
+typedef union {
+    struct {
+        size_t size;
+        const char* site;
+        TFMemAccount* account;
+    } info;
+    max_align_t align;
+} MemHeader;
+
+typedef struct {
+    const char* site;
+    uint64_t count;
+    uint64_t bytes;
+    int64_t live_bytes;
+    int64_t live_blocks;
+} MemSite;
+
+static int mem_enabled = 0;
+static uint64_t mem_allocations = 0;
+static uint64_t mem_frees = 0;
+static uint64_t mem_bytes = 0;
+static int64_t mem_live_bytes = 0;
+static int64_t mem_live_blocks = 0;
+static int64_t mem_peak_bytes = 0;
+static MemSite mem_sites[MEM_SITE_CAPACITY];
+static MemSite mem_overflow_site = { "(outros)", 0, 0, 0, 0 };
+static __thread TFMemAccount* mem_current_account = NULL;
+
+void tf_mem_stats_enable(void) {
+    __atomic_store_n(&mem_enabled, 1, __ATOMIC_RELEASE);
+}
+
+int tf_mem_stats_enabled(void) {
+    return __atomic_load_n(&mem_enabled, __ATOMIC_ACQUIRE);
+}
+
+long long tf_mem_live_bytes(void) {
+    return (long long)__atomic_load_n(&mem_live_bytes, __ATOMIC_RELAXED);
+}
+
+TFMemAccount* tf_mem_account_create(void) {
+    TFMemAccount* account = (TFMemAccount*)malloc(sizeof(TFMemAccount));
+    if (account == NULL) return NULL;
+    
+    account->live_bytes = 0;
+    account->references = 1;
+    return account;
+}
+
+void tf_mem_account_release(TFMemAccount* account) {
+    if (account == NULL) return;
+    
+    if (__atomic_sub_fetch(&account->references, 1, __ATOMIC_ACQ_REL) == 0) {
+        free(account);
+    }
+}
+
+long long tf_mem_account_live_bytes(const TFMemAccount* account) {
+    return (long long)__atomic_load_n(&account->live_bytes, __ATOMIC_RELAXED);
+}
+
+TFMemAccount* tf_mem_account_enter(TFMemAccount* account) {
+    TFMemAccount* previous = mem_current_account;
+    mem_current_account = account;
+    return previous;
+}
+
+void tf_mem_account_leave(TFMemAccount* previous) {
+    mem_current_account = previous;
+}
+
+static MemSite* find_site(const char* site) {
+    size_t hash = ((uintptr_t)site >> 3) * 0x9E3779B97F4A7C15ull;
+    
+    for (size_t probe = 0; probe < MEM_SITE_CAPACITY; probe++) {
+        MemSite* entry = &mem_sites[(hash + probe) % MEM_SITE_CAPACITY];
+        const char* current = __atomic_load_n(&entry->site, __ATOMIC_ACQUIRE);
+        
+        if (current == site) return entry;
+        if (current == NULL) {
+            const char* expected = NULL;
+            if (__atomic_compare_exchange_n(&entry->site, &expected, site, false,
+                                            __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) || expected == site) {
+                return entry;
+            }
+        }
+    }
+    
+    return &mem_overflow_site;
+}
+
+static void record_allocation(MemHeader* header, size_t size, const char* site) {
+    header->info.size = size;
+    header->info.site = NULL;
+    header->info.account = mem_current_account;
+    
+    if (header->info.account != NULL) {
+        __atomic_fetch_add(&header->info.account->references, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&header->info.account->live_bytes, (int64_t)size, __ATOMIC_RELAXED);
+    }
+    
+    if (!tf_mem_stats_enabled()) return;
+    
+    MemSite* entry = find_site(site);
+    header->info.site = entry->site;
+    
+    __atomic_fetch_add(&entry->count, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&entry->bytes, size, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&entry->live_bytes, (int64_t)size, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&entry->live_blocks, 1, __ATOMIC_RELAXED);
+    
+    __atomic_fetch_add(&mem_allocations, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&mem_bytes, size, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&mem_live_blocks, 1, __ATOMIC_RELAXED);
+    int64_t live = __atomic_add_fetch(&mem_live_bytes, (int64_t)size, __ATOMIC_RELAXED);
+    
+    int64_t peak = __atomic_load_n(&mem_peak_bytes, __ATOMIC_RELAXED);
+    while (live > peak &&
+           !__atomic_compare_exchange_n(&mem_peak_bytes, &peak, live, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+static void record_free(MemHeader* header) {
+    if (header->info.account != NULL) {
+        __atomic_fetch_sub(&header->info.account->live_bytes, (int64_t)header->info.size, __ATOMIC_RELAXED);
+        tf_mem_account_release(header->info.account);
+    }
+    
+    if (header->info.site == NULL) return;
+    
+    MemSite* entry = find_site(header->info.site);
+    size_t size = header->info.size;
+    
+    __atomic_fetch_sub(&entry->live_bytes, (int64_t)size, __ATOMIC_RELAXED);
+    __atomic_fetch_sub(&entry->live_blocks, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&mem_frees, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_sub(&mem_live_bytes, (int64_t)size, __ATOMIC_RELAXED);
+    __atomic_fetch_sub(&mem_live_blocks, 1, __ATOMIC_RELAXED);
+}
+
+void* tf_mem_malloc(size_t size, const char* site) {
+    MemHeader* header = (MemHeader*)malloc(sizeof(MemHeader) + size);
+    if (header == NULL) return NULL;
+    
+    record_allocation(header, size, site);
+    return header + 1;
+}
+
+void* tf_mem_calloc(size_t count, size_t size, const char* site) {
+    if (size != 0 && count > (SIZE_MAX - sizeof(MemHeader)) / size) return NULL;
+    
+    MemHeader* header = (MemHeader*)calloc(1, sizeof(MemHeader) + count * size);
+    if (header == NULL) return NULL;
+    
+    record_allocation(header, count * size, site);
+    return header + 1;
+}
+
+void* tf_mem_realloc(void* ptr, size_t size, const char* site) {
+    if (ptr == NULL) return tf_mem_malloc(size, site);
+    
+    MemHeader* header = (MemHeader*)ptr - 1;
+    MemHeader saved = *header;
+    
+    MemHeader* new_header = (MemHeader*)realloc(header, sizeof(MemHeader) + size);
+    if (new_header == NULL) return NULL;
+    
+    record_free(&saved);
+    record_allocation(new_header, size, site);
+    return new_header + 1;
+}
+
+char* tf_mem_strdup(const char* str, const char* site) {
+    size_t length = strlen(str) + 1;
+    char* copy = (char*)tf_mem_malloc(length, site);
+    
+    if (copy != NULL) {
+        memcpy(copy, str, length);
+    }
+    return copy;
+}
+
+void tf_mem_free(void* ptr) {
+    if (ptr == NULL) return;
+    
+    MemHeader* header = (MemHeader*)ptr - 1;
+    record_free(header);
+    free(header);
+}
+
+static int compare_sites(const void* a, const void* b) {
+    const MemSite* left = *(const MemSite* const*)a;
+    const MemSite* right = *(const MemSite* const*)b;
+    
+    if (left->bytes != right->bytes) return left->bytes < right->bytes ? 1 : -1;
+    if (left->count != right->count) return left->count < right->count ? 1 : -1;
+    return 0;
+}
+
+void tf_mem_stats_report(FILE* out) {
+    MemSite* sites[MEM_SITE_CAPACITY + 1];
+    size_t site_count = 0;
+    
+    for (size_t i = 0; i < MEM_SITE_CAPACITY; i++) {
+        if (__atomic_load_n(&mem_sites[i].site, __ATOMIC_ACQUIRE) != NULL) {
+            sites[site_count++] = &mem_sites[i];
+        }
+    }
+    if (mem_overflow_site.count > 0) {
+        sites[site_count++] = &mem_overflow_site;
+    }
+    
+    qsort(sites, site_count, sizeof(MemSite*), compare_sites);
+    
+    fprintf(out, "Estatísticas de memória:\n");
+    fprintf(out, "  alocações:            %llu\n", (unsigned long long)mem_allocations);
+    fprintf(out, "  liberações:           %llu\n", (unsigned long long)mem_frees);
+    fprintf(out, "  bytes alocados:       %llu\n", (unsigned long long)mem_bytes);
+    fprintf(out, "  pico de bytes vivos:  %lld\n", (long long)mem_peak_bytes);
+    fprintf(out, "  vivos ao final:       %lld bytes em %lld blocos\n",
+            (long long)mem_live_bytes, (long long)mem_live_blocks);
+    
+    if (site_count == 0) return;
+    
+    fprintf(out, "  Principais locais de alocação:\n");
+    fprintf(out, "    %12s %14s %14s  %s\n", "contagem", "bytes", "vivos", "local");
+    for (size_t i = 0; i < site_count && i < MEM_TOP_SITES; i++) {
+        fprintf(out, "    %12llu %14llu %14lld  %s\n",
+                (unsigned long long)sites[i]->count,
+                (unsigned long long)sites[i]->bytes,
+                (long long)sites[i]->live_bytes,
+                sites[i]->site);
+    }
+}
@@ -0,0 +1,36 @@
+#ifndef MEM_STATS_H
+#define MEM_STATS_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+#define TF_MEM_STRINGIFY(x) #x
+#define TF_MEM_LINE(x) TF_MEM_STRINGIFY(x)
+#define TF_MEM_SITE __FILE__ ":" TF_MEM_LINE(__LINE__)
+
+#define tf_malloc(size) tf_mem_malloc((size), TF_MEM_SITE)
+#define tf_calloc(count, size) tf_mem_calloc((count), (size), TF_MEM_SITE)
+#define tf_realloc(ptr, size) tf_mem_realloc((ptr), (size), TF_MEM_SITE)
+#define tf_strdup(str) tf_mem_strdup((str), TF_MEM_SITE)
+#define tf_free(ptr) tf_mem_free(ptr)
+
+typedef struct TFMemAccount TFMemAccount;
+
+void* tf_mem_malloc(size_t size, const char* site);
+void* tf_mem_calloc(size_t count, size_t size, const char* site);
+void* tf_mem_realloc(void* ptr, size_t size, const char* site);
+char* tf_mem_strdup(const char* str, const char* site);
+void tf_mem_free(void* ptr);
+
+void tf_mem_stats_enable(void);
+int tf_mem_stats_enabled(void);
+long long tf_mem_live_bytes(void);
+void tf_mem_stats_report(FILE* out);
+
+TFMemAccount* tf_mem_account_create(void);
+void tf_mem_account_release(TFMemAccount* account);
+long long tf_mem_account_live_bytes(const TFMemAccount* account);
+TFMemAccount* tf_mem_account_enter(TFMemAccount* account);
+void tf_mem_account_leave(TFMemAccount* previous);
+
+#endif
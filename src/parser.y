@@ -2,10 +2,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "mem_stats.h"
 
 extern int yylex();
 extern int yylineno;
 extern char* yytext;
+extern FILE* yyin;
+extern void yyrestart(FILE* input_file);
 void yyerror(const char* s);
 
 typedef enum {
@@ -24,11 +29,20 @@ typedef enum {
     NODE_INT_VAL,
     NODE_STRING_VAL,
     NODE_BOOL_VAL,
-    NODE_IDENTIFIER
+    NODE_IDENTIFIER,
+    NODE_READ,
+    NODE_PARALLEL_FOR,
+    NODE_SPAWN,
+    NODE_CHANNEL_DECL,
+    NODE_SEND,
+    NODE_RECEIVE,
+    NODE_CLOSE,
+    NODE_RECEIVE_LOOP
 } NodeType;
 
 typedef struct Node {
     NodeType type;
+    int line;
     union {
         int int_value;
         char* str_value;
@@ -64,9 +78,38 @@ typedef struct Node {
             struct Node* body;
             struct Node* condition;
         } repeat_stmt;
+        struct {
+            char* var_name;
+            struct Node* start;
+            struct Node* end;
+            struct Node* body;
+            char** reduce_ops;
+            char** reduce_vars;
+            int reduce_count;
+        } parallel_for;
+        struct {
+            struct Node* body;
+        } spawn;
+        struct {
+            char* name;
+            char* data_type;
+            struct Node* capacity;
+        } channel_decl;
+        struct {
+            char* channel;
+            struct Node* value;
+        } channel_op;
+        struct {
+            char* var_name;
+            char* channel;
+            struct Node* body;
+        } receive_loop;
         struct {
             struct Node* expr;
         } print_stmt;
+        struct {
+            char* data_type;
+        } read_expr;
         struct {
             struct Node* condition;
             struct Node** cases;
@@ -107,8 +150,26 @@ Node* create_int_val_node(int value);
 Node* create_string_val_node(char* value);
 Node* create_bool_val_node(int value);
 Node* create_identifier_node(char* name);
+Node* create_read_node(char* type);
+Node* create_parallel_for_node();
+void add_reduction_to_parallel_for(Node* parallel_node, char* op, char* var_name);
+Node* create_spawn_node(Node* body);
+Node* create_channel_decl_node(char* name, char* type, Node* capacity);
+Node* create_channel_op_node(NodeType type, char* channel, Node* value);
+Node* create_receive_loop_node(char* var_name, char* channel, Node* body);
+
+Node* parse_program(FILE* input, char* error, size_t error_size);
+Node* parse_statements(FILE* input, bool* incomplete, char* error, size_t error_size);
+void free_ast(Node* node);
 
 Node* ast_root = NULL;
+int tf_start_token = 0;
+
+static pthread_mutex_t parse_lock = PTHREAD_MUTEX_INITIALIZER;
+static char* parse_error = NULL;
+static size_t parse_error_size = 0;
+static int parse_error_count = 0;
+static bool parse_incomplete = false;
 %}
 
 %union {
@@ -120,6 +181,11 @@ Node* ast_root = NULL;
 
 %token BOOT SHUTDOWN
 %token BYTE STREAM PING PONG LOG REPEAT UNTIL SELECT WHEN OTHERWISE THEN END
+%token READER
+%token REPL_START
+%token PARALLEL REDUCE
+%token SPAWN FROM TO
+%token CHANNEL SEND RECEIVE CLOSE
 %token <strval> TYPE
 %token <strval> IDENTIFIER
 %token <intval> NUMBER
@@ -132,32 +198,41 @@ Node* ast_root = NULL;
 %token ASSIGN SEMICOLON COLON COMMA LPAREN RPAREN
 
 %type <node> program statements statement var_decl if_stmt while_stmt repeat_stmt
+%type <node> parallel_stmt reduction_list
+%type <node> spawn_stmt channel_decl send_stmt close_stmt receive_loop
+%type <strval> reduce_op
 %type <node> select_stmt case_stmt default_stmt log_stmt expr_stmt case_list
 %type <node> expression concat_expr logical_or logical_and equality relational
 %type <node> additive term factor primary
 
-%start program
+%destructor { free_ast($$); } <node>
+%destructor { tf_free($$); } TYPE IDENTIFIER STRING
+
+%start unit
+%expect 0
 
 %%
 
+unit
+    : program
+        { ast_root = $1; }
+    | REPL_START statements
+        { ast_root = $2; }
+    ;
+
 program
     : BOOT statements SHUTDOWN
-        { ast_root = create_program_node($2); }
+        { $$ = create_program_node($2); }
     ;
 
 statements
-    : statement
-        { 
-            $$ = create_block_node();
-            add_statement_to_block($$, $1);
-        }
+    :
+        { $$ = create_block_node(); }
     | statements statement
         {
             $$ = $1;
             add_statement_to_block($$, $2);
         }
-    |
-        { $$ = create_block_node(); }
     ;
 
 statement
@@ -167,6 +242,18 @@ statement
         { $$ = $1; }
     | while_stmt
         { $$ = $1; }
+    | parallel_stmt
+        { $$ = $1; }
+    | receive_loop
+        { $$ = $1; }
+    | spawn_stmt
+        { $$ = $1; }
+    | channel_decl
+        { $$ = $1; }
+    | send_stmt
+        { $$ = $1; }
+    | close_stmt
+        { $$ = $1; }
     | repeat_stmt
         { $$ = $1; }
     | select_stmt
@@ -200,6 +287,65 @@ while_stmt
         { $$ = create_while_node($3, $6); }
     ;
 
+parallel_stmt
+    : STREAM PARALLEL LPAREN IDENTIFIER FROM expression TO expression RPAREN reduction_list THEN statements END
+        {
+            $$ = $10;
+            $$->data.parallel_for.var_name = $4;
+            $$->data.parallel_for.start = $6;
+            $$->data.parallel_for.end = $8;
+            $$->data.parallel_for.body = $12;
+        }
+    ;
+
+reduction_list
+    :
+        { $$ = create_parallel_for_node(); }
+    | reduction_list REDUCE LPAREN reduce_op COLON IDENTIFIER RPAREN
+        {
+            $$ = $1;
+            add_reduction_to_parallel_for($$, $4, $6);
+        }
+    ;
+
+reduce_op
+    : PLUS
+        { $$ = "+"; }
+    | MULTIPLY
+        { $$ = "*"; }
+    | AND
+        { $$ = "AND"; }
+    | OR
+        { $$ = "OR"; }
+    ;
+
+receive_loop
+    : STREAM LPAREN IDENTIFIER FROM IDENTIFIER RPAREN THEN statements END
+        { $$ = create_receive_loop_node($3, $5, $8); }
+    ;
+
+spawn_stmt
+    : SPAWN THEN statements END
+        { $$ = create_spawn_node($3); }
+    ;
+
+channel_decl
+    : CHANNEL IDENTIFIER COLON TYPE SEMICOLON
+        { $$ = create_channel_decl_node($2, $4, NULL); }
+    | CHANNEL IDENTIFIER COLON TYPE LPAREN expression RPAREN SEMICOLON
+        { $$ = create_channel_decl_node($2, $4, $6); }
+    ;
+
+send_stmt
+    : SEND LPAREN IDENTIFIER COMMA expression RPAREN SEMICOLON
+        { $$ = create_channel_op_node(NODE_SEND, $3, $5); }
+    ;
+
+close_stmt
+    : CLOSE LPAREN IDENTIFIER RPAREN SEMICOLON
+        { $$ = create_channel_op_node(NODE_CLOSE, $3, NULL); }
+    ;
+
 repeat_stmt
     : REPEAT THEN statements UNTIL expression SEMICOLON
         { $$ = create_repeat_node($3, $5); }
@@ -239,9 +385,7 @@ default_stmt
     ;
 
 log_stmt
-    : LOG LPAREN expression RPAREN SEMICOLON
-        { $$ = create_print_node($3); }
-    | LOG LPAREN expression RPAREN
+    : LOG LPAREN expression RPAREN
         { $$ = create_print_node($3); }
     ;
 
@@ -338,6 +482,19 @@ primary
         { $$ = create_bool_val_node($1); }
     | IDENTIFIER
         { $$ = create_identifier_node($1); }
+    | READER LPAREN RPAREN
+        { $$ = create_read_node(tf_strdup("i32")); }
+    | READER LPAREN TYPE RPAREN
+        {
+            if (strcmp($3, "i32") != 0 && strcmp($3, "str") != 0) {
+                yyerror("reader suporta apenas i32 e str");
+                tf_free($3);
+                YYERROR;
+            }
+            $$ = create_read_node($3);
+        }
+    | RECEIVE LPAREN IDENTIFIER RPAREN
+        { $$ = create_channel_op_node(NODE_RECEIVE, $3, NULL); }
     | LPAREN expression RPAREN
         { $$ = $2; }
     ;
@@ -345,21 +502,173 @@ primary
 %%
 
 void yyerror(const char* s) {
-    fprintf(stderr, "Erro (linha %d): %s próximo a '%s'\n", yylineno, s, yytext);
-    exit(1);
+    if (parse_error_count++ == 0 && parse_error != NULL) {
+        parse_incomplete = yychar == YYEOF;
+        snprintf(parse_error, parse_error_size, "Erro (linha %d): %s próximo a '%s'", yylineno, s, yytext);
+    }
+}
+
+static Node* parse_input(FILE* input, int start_token, bool* incomplete, char* error, size_t error_size) {
+    pthread_mutex_lock(&parse_lock);
+    
+    parse_error = error;
+    parse_error_size = error_size;
+    parse_error_count = 0;
+    parse_incomplete = false;
+    ast_root = NULL;
+    tf_start_token = start_token;
+    yylineno = 1;
+    yyin = input;
+    yyrestart(input);
+    
+    int result = yyparse();
+    Node* root = ast_root;
+    
+    if (result != 0 || parse_error_count > 0) {
+        if (parse_error_count == 0) {
+            snprintf(error, error_size, "Erro durante a análise sintática");
+        }
+        free_ast(root);
+        root = NULL;
+    }
+    
+    if (incomplete != NULL) {
+        *incomplete = root == NULL && parse_incomplete;
+    }
+    
+    ast_root = NULL;
+    parse_error = NULL;
+    tf_start_token = 0;
+    pthread_mutex_unlock(&parse_lock);
+    
+    return root;
+}
+
+Node* parse_program(FILE* input, char* error, size_t error_size) {
+    return parse_input(input, 0, NULL, error, error_size);
+}
+
+Node* parse_statements(FILE* input, bool* incomplete, char* error, size_t error_size) {
+    return parse_input(input, REPL_START, incomplete, error, error_size);
+}
+
+void free_ast(Node* node) {
+    if (node == NULL) return;
+    
+    switch (node->type) {
+        case NODE_PROGRAM:
+            free_ast(node->data.program.body);
+            break;
+        case NODE_BLOCK:
+            for (int i = 0; i < node->data.block.stmt_count; i++) {
+                free_ast(node->data.block.statements[i]);
+            }
+            tf_free(node->data.block.statements);
+            break;
+        case NODE_VAR_DECL:
+            tf_free(node->data.var_decl.name);
+            tf_free(node->data.var_decl.data_type);
+            free_ast(node->data.var_decl.init_expr);
+            break;
+        case NODE_ASSIGN:
+            tf_free(node->data.assign.name);
+            free_ast(node->data.assign.value);
+            break;
+        case NODE_IF:
+            free_ast(node->data.if_stmt.condition);
+            free_ast(node->data.if_stmt.then_branch);
+            free_ast(node->data.if_stmt.else_branch);
+            break;
+        case NODE_WHILE:
+            free_ast(node->data.while_stmt.condition);
+            free_ast(node->data.while_stmt.body);
+            break;
+        case NODE_REPEAT:
+            free_ast(node->data.repeat_stmt.body);
+            free_ast(node->data.repeat_stmt.condition);
+            break;
+        case NODE_PARALLEL_FOR:
+            tf_free(node->data.parallel_for.var_name);
+            free_ast(node->data.parallel_for.start);
+            free_ast(node->data.parallel_for.end);
+            free_ast(node->data.parallel_for.body);
+            for (int i = 0; i < node->data.parallel_for.reduce_count; i++) {
+                tf_free(node->data.parallel_for.reduce_ops[i]);
+                tf_free(node->data.parallel_for.reduce_vars[i]);
+            }
+            tf_free(node->data.parallel_for.reduce_ops);
+            tf_free(node->data.parallel_for.reduce_vars);
+            break;
+        case NODE_SWITCH:
+            free_ast(node->data.switch_stmt.condition);
+            for (int i = 0; i < node->data.switch_stmt.case_count; i++) {
+                free_ast(node->data.switch_stmt.cases[i]);
+            }
+            tf_free(node->data.switch_stmt.cases);
+            free_ast(node->data.switch_stmt.default_case);
+            break;
+        case NODE_CASE:
+            free_ast(node->data.case_stmt.value);
+            free_ast(node->data.case_stmt.body);
+            break;
+        case NODE_PRINT:
+            free_ast(node->data.print_stmt.expr);
+            break;
+        case NODE_BINARY_OP:
+            tf_free(node->data.binary_op.operator);
+            free_ast(node->data.binary_op.left);
+            free_ast(node->data.binary_op.right);
+            break;
+        case NODE_UNARY_OP:
+            tf_free(node->data.unary_op.operator);
+            free_ast(node->data.unary_op.operand);
+            break;
+        case NODE_STRING_VAL:
+        case NODE_IDENTIFIER:
+            tf_free(node->data.str_value);
+            break;
+        case NODE_READ:
+            tf_free(node->data.read_expr.data_type);
+            break;
+        case NODE_SPAWN:
+            free_ast(node->data.spawn.body);
+            break;
+        case NODE_CHANNEL_DECL:
+            tf_free(node->data.channel_decl.name);
+            tf_free(node->data.channel_decl.data_type);
+            free_ast(node->data.channel_decl.capacity);
+            break;
+        case NODE_SEND:
+        case NODE_RECEIVE:
+        case NODE_CLOSE:
+            tf_free(node->data.channel_op.channel);
+            free_ast(node->data.channel_op.value);
+            break;
+        case NODE_RECEIVE_LOOP:
+            tf_free(node->data.receive_loop.var_name);
+            tf_free(node->data.receive_loop.channel);
+            free_ast(node->data.receive_loop.body);
+            break;
+        default:
+            break;
+    }
+    
+    tf_free(node);
 }
 
 Node* create_program_node(Node* body) {
-    Node* node = (Node*)malloc(sizeof(Node));
+    Node* node = (Node*)tf_malloc(sizeof(Node));
     node->type = NODE_PROGRAM;
+    node->line = body->line;
     node->data.program.body = body;
     node->next = NULL;
     return node;
 }
 
 Node* create_block_node() {
-    Node* node = (Node*)malloc(sizeof(Node));
+    Node* node = (Node*)tf_malloc(sizeof(Node));
     node->type = NODE_BLOCK;
+    node->line = yylineno;
     node->data.block.statements = NULL;
     node->data.block.stmt_count = 0;
     node->next = NULL;
@@ -370,7 +679,7 @@ void add_statement_to_block(Node* block, Node* statement) {
     if (statement == NULL) return;
     
     block->data.block.stmt_count++;
-    Node** new_statements = (Node**)realloc(
+    Node** new_statements = (Node**)tf_realloc(
         block->data.block.statements, 
         block->data.block.stmt_count * sizeof(Node*)
     );
@@ -385,8 +694,9 @@ void add_statement_to_block(Node* block, Node* statement) {
 }
 
 Node* create_var_decl_node(char* name, char* type, Node* init_expr) {
-    Node* node = (Node*)malloc(sizeof(Node));
+    Node* node = (Node*)tf_malloc(sizeof(Node));
     node->type = NODE_VAR_DECL;
+    node->line = yylineno;
     node->data.var_decl.name = name;
     node->data.var_decl.data_type = type;
     node->data.var_decl.init_expr = init_expr;
@@ -395,8 +705,9 @@ Node* create_var_decl_node(char* name, char* type, Node* init_expr) {
 }
 
 Node* create_assign_node(char* name, Node* value) {
-    Node* node = (Node*)malloc(sizeof(Node));
+    Node* node = (Node*)tf_malloc(sizeof(Node));
     node->type = NODE_ASSIGN;
+    node->line = yylineno;
     node->data.assign.name = name;
     node->data.assign.value = value;
     node->next = NULL;
@@ -404,8 +715,9 @@ Node* create_assign_node(char* name, Node* value) {
 }
 
 Node* create_if_node(Node* condition, Node* then_branch, Node* else_branch) {
-    Node* node = (Node*)malloc(sizeof(Node));
+    Node* node = (Node*)tf_malloc(sizeof(Node));
     node->type = NODE_IF;
+    node->line = condition->line;
     node->data.if_stmt.condition = condition;
     node->data.if_stmt.then_branch = then_branch;
     node->data.if_stmt.else_branch = else_branch;
@@ -414,8 +726,9 @@ Node* create_if_node(Node* condition, Node* then_branch, Node* else_branch) {
 }
 
 Node* create_while_node(Node* condition, Node* body) {
-    Node* node = (Node*)malloc(sizeof(Node));
+    Node* node = (Node*)tf_malloc(sizeof(Node));
     node->type = NODE_WHILE;
+    node->line = condition->line;
     node->data.while_stmt.condition = condition;
     node->data.while_stmt.body = body;
     node->next = NULL;
@@ -423,8 +736,9 @@ Node* create_while_node(Node* condition, Node* body) {
 }
 
 Node* create_repeat_node(Node* body, Node* condition) {
-    Node* node = (Node*)malloc(sizeof(Node));
+    Node* node = (Node*)tf_malloc(sizeof(Node));
     node->type = NODE_REPEAT;
+    node->line = body->line;
     node->data.repeat_stmt.body = body;
     node->data.repeat_stmt.condition = condition;
     node->next = NULL;
@@ -432,8 +746,9 @@ Node* create_repeat_node(Node* body, Node* condition) {
 }
 
 Node* create_switch_node(Node* condition) {
-    Node* node = (Node*)malloc(sizeof(Node));
+    Node* node = (Node*)tf_malloc(sizeof(Node));
     node->type = NODE_SWITCH;
+    node->line = yylineno;
     node->data.switch_stmt.condition = condition;
     node->data.switch_stmt.cases = NULL;
     node->data.switch_stmt.case_count = 0;
@@ -443,8 +758,9 @@ Node* create_switch_node(Node* condition) {
 }
 
 Node* create_case_node(Node* value, Node* body) {
-    Node* node = (Node*)malloc(sizeof(Node));
+    Node* node = (Node*)tf_malloc(sizeof(Node));
     node->type = NODE_CASE;
+    node->line = value->line;
     node->data.case_stmt.value = value;
     node->data.case_stmt.body = body;
     node->next = NULL;
@@ -453,7 +769,7 @@ Node* create_case_node(Node* value, Node* body) {
 
 void add_case_to_switch(Node* switch_node, Node* case_node) {
     switch_node->data.switch_stmt.case_count++;
-    Node** new_cases = (Node**)realloc(
+    Node** new_cases = (Node**)tf_realloc(
         switch_node->data.switch_stmt.cases, 
         switch_node->data.switch_stmt.case_count * sizeof(Node*)
     );
@@ -468,21 +784,24 @@ void add_case_to_switch(Node* switch_node, Node* case_node) {
 }
 
 void set_default_case(Node* switch_node, Node* default_case) {
+    free_ast(switch_node->data.switch_stmt.default_case);
     switch_node->data.switch_stmt.default_case = default_case;
 }
 
 Node* create_print_node(Node* expr) {
-    Node* node = (Node*)malloc(sizeof(Node));
+    Node* node = (Node*)tf_malloc(sizeof(Node));
     node->type = NODE_PRINT;
+    node->line = yylineno;
     node->data.print_stmt.expr = expr;
     node->next = NULL;
     return node;
 }
 
 Node* create_binary_op_node(char* op, Node* left, Node* right) {
-    Node* node = (Node*)malloc(sizeof(Node));
+    Node* node = (Node*)tf_malloc(sizeof(Node));
     node->type = NODE_BINARY_OP;
-    node->data.binary_op.operator = strdup(op);
+    node->line = left->line;
+    node->data.binary_op.operator = tf_strdup(op);
     node->data.binary_op.left = left;
     node->data.binary_op.right = right;
     node->next = NULL;
@@ -490,42 +809,130 @@ Node* create_binary_op_node(char* op, Node* left, Node* right) {
 }
 
 Node* create_unary_op_node(char* op, Node* operand) {
-    Node* node = (Node*)malloc(sizeof(Node));
+    Node* node = (Node*)tf_malloc(sizeof(Node));
     node->type = NODE_UNARY_OP;
-    node->data.unary_op.operator = strdup(op);
+    node->line = yylineno;
+    node->data.unary_op.operator = tf_strdup(op);
     node->data.unary_op.operand = operand;
     node->next = NULL;
     return node;
 }
 
 Node* create_int_val_node(int value) {
-    Node* node = (Node*)malloc(sizeof(Node));
+    Node* node = (Node*)tf_malloc(sizeof(Node));
     node->type = NODE_INT_VAL;
+    node->line = yylineno;
     node->data.int_value = value;
     node->next = NULL;
     return node;
 }
 
 Node* create_string_val_node(char* value) {
-    Node* node = (Node*)malloc(sizeof(Node));
+    Node* node = (Node*)tf_malloc(sizeof(Node));
     node->type = NODE_STRING_VAL;
+    node->line = yylineno;
     node->data.str_value = value;
     node->next = NULL;
     return node;
 }
 
 Node* create_bool_val_node(int value) {
-    Node* node = (Node*)malloc(sizeof(Node));
+    Node* node = (Node*)tf_malloc(sizeof(Node));
     node->type = NODE_BOOL_VAL;
+    node->line = yylineno;
     node->data.bool_value = value;
     node->next = NULL;
     return node;
 }
 
 Node* create_identifier_node(char* name) {
-    Node* node = (Node*)malloc(sizeof(Node));
+    Node* node = (Node*)tf_malloc(sizeof(Node));
     node->type = NODE_IDENTIFIER;
+    node->line = yylineno;
     node->data.str_value = name;
     node->next = NULL;
     return node;
-}
\ No newline at end of file
+}
+
+Node* create_read_node(char* type) {
+    Node* node = (Node*)tf_malloc(sizeof(Node));
+    node->type = NODE_READ;
+    node->line = yylineno;
+    node->data.read_expr.data_type = type;
+    node->next = NULL;
+    return node;
+}
+
+Node* create_parallel_for_node() {
+    Node* node = (Node*)tf_malloc(sizeof(Node));
+    node->type = NODE_PARALLEL_FOR;
+    node->line = yylineno;
+    node->data.parallel_for.var_name = NULL;
+    node->data.parallel_for.start = NULL;
+    node->data.parallel_for.end = NULL;
+    node->data.parallel_for.body = NULL;
+    node->data.parallel_for.reduce_ops = NULL;
+    node->data.parallel_for.reduce_vars = NULL;
+    node->data.parallel_for.reduce_count = 0;
+    node->next = NULL;
+    return node;
+}
+
+void add_reduction_to_parallel_for(Node* parallel_node, char* op, char* var_name) {
+    int count = parallel_node->data.parallel_for.reduce_count + 1;
+    char** new_ops = (char**)tf_realloc(parallel_node->data.parallel_for.reduce_ops, count * sizeof(char*));
+    char** new_vars = (char**)tf_realloc(parallel_node->data.parallel_for.reduce_vars, count * sizeof(char*));
+    
+    if (new_ops == NULL || new_vars == NULL) {
+        fprintf(stderr, "Erro de alocação de memória\n");
+        exit(1);
+    }
+    
+    new_ops[count - 1] = tf_strdup(op);
+    new_vars[count - 1] = var_name;
+    
+    parallel_node->data.parallel_for.reduce_ops = new_ops;
+    parallel_node->data.parallel_for.reduce_vars = new_vars;
+    parallel_node->data.parallel_for.reduce_count = count;
+}
+
+Node* create_spawn_node(Node* body) {
+    Node* node = (Node*)tf_malloc(sizeof(Node));
+    node->type = NODE_SPAWN;
+    node->line = body->line;
+    node->data.spawn.body = body;
+    node->next = NULL;
+    return node;
+}
+
+Node* create_channel_decl_node(char* name, char* type, Node* capacity) {
+    Node* node = (Node*)tf_malloc(sizeof(Node));
+    node->type = NODE_CHANNEL_DECL;
+    node->line = yylineno;
+    node->data.channel_decl.name = name;
+    node->data.channel_decl.data_type = type;
+    node->data.channel_decl.capacity = capacity;
+    node->next = NULL;
+    return node;
+}
+
+Node* create_channel_op_node(NodeType type, char* channel, Node* value) {
+    Node* node = (Node*)tf_malloc(sizeof(Node));
+    node->type = type;
+    node->line = yylineno;
+    node->data.channel_op.channel = channel;
+    node->data.channel_op.value = value;
+    node->next = NULL;
+    return node;
+}
+
+Node* create_receive_loop_node(char* var_name, char* channel, Node* body) {
+    Node* node = (Node*)tf_malloc(sizeof(Node));
+    node->type = NODE_RECEIVE_LOOP;
+    node->line = body->line;
+    node->data.receive_loop.var_name = var_name;
+    node->data.receive_loop.channel = channel;
+    node->data.receive_loop.body = body;
+    node->next = NULL;
+    return node;
+}
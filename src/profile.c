@@ -0,0 +1,214 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "profile.h"
+
+struct Profile {
+    ProfileEntry* entries;
+    int entry_count;
+    int capacity;
+    int* buckets;
+    int bucket_count;
+};
+
+static const char* profile_kind(const Node* node) {
+    switch (node->type) {
+        case NODE_IF: return "ping";
+        case NODE_WHILE: return "stream";
+        case NODE_REPEAT: return "repeat";
+        case NODE_SWITCH: return "select";
+        default: return NULL;
+    }
+}
+
+static void add_entry(Profile* profile, const Node* node, int count_size) {
+    if (profile->entry_count == profile->capacity) {
+        profile->capacity = profile->capacity == 0 ? 16 : profile->capacity * 2;
+        profile->entries = (ProfileEntry*)realloc(profile->entries, profile->capacity * sizeof(ProfileEntry));
+    }
+    
+    ProfileEntry* entry = &profile->entries[profile->entry_count++];
+    entry->node = node;
+    entry->count_size = count_size;
+    entry->counts = (uint64_t*)calloc(count_size, sizeof(uint64_t));
+}
+
+static void collect_entries(Profile* profile, const Node* node) {
+    if (node == NULL) return;
+    
+    switch (node->type) {
+        case NODE_PROGRAM:
+            collect_entries(profile, node->data.program.body);
+            break;
+        case NODE_BLOCK:
+            for (int i = 0; i < node->data.block.stmt_count; i++) {
+                collect_entries(profile, node->data.block.statements[i]);
+            }
+            break;
+        case NODE_IF:
+            add_entry(profile, node, 2);
+            collect_entries(profile, node->data.if_stmt.then_branch);
+            collect_entries(profile, node->data.if_stmt.else_branch);
+            break;
+        case NODE_WHILE:
+            add_entry(profile, node, 2);
+            collect_entries(profile, node->data.while_stmt.body);
+            break;
+        case NODE_REPEAT:
+            add_entry(profile, node, 2);
+            collect_entries(profile, node->data.repeat_stmt.body);
+            break;
+        case NODE_PARALLEL_FOR:
+            collect_entries(profile, node->data.parallel_for.body);
+            break;
+        case NODE_SPAWN:
+            collect_entries(profile, node->data.spawn.body);
+            break;
+        case NODE_RECEIVE_LOOP:
+            collect_entries(profile, node->data.receive_loop.body);
+            break;
+        case NODE_SWITCH:
+            add_entry(profile, node, node->data.switch_stmt.case_count + 1);
+            for (int i = 0; i < node->data.switch_stmt.case_count; i++) {
+                collect_entries(profile, node->data.switch_stmt.cases[i]->data.case_stmt.body);
+            }
+            collect_entries(profile, node->data.switch_stmt.default_case);
+            break;
+        default:
+            break;
+    }
+}
+
+static size_t hash_node(const Node* node, int bucket_count) {
+    return (size_t)(((uintptr_t)node >> 4) * 0x9E3779B97F4A7C15ull) & (size_t)(bucket_count - 1);
+}
+
+Profile* create_profile(Node* root) {
+    Profile* profile = (Profile*)calloc(1, sizeof(Profile));
+    collect_entries(profile, root);
+    
+    profile->bucket_count = 16;
+    while (profile->bucket_count < profile->entry_count * 2) {
+        profile->bucket_count *= 2;
+    }
+    
+    profile->buckets = (int*)malloc(profile->bucket_count * sizeof(int));
+    for (int i = 0; i < profile->bucket_count; i++) {
+        profile->buckets[i] = -1;
+    }
+    
+    for (int i = 0; i < profile->entry_count; i++) {
+        size_t bucket = hash_node(profile->entries[i].node, profile->bucket_count);
+        while (profile->buckets[bucket] != -1) {
+            bucket = (bucket + 1) & (size_t)(profile->bucket_count - 1);
+        }
+        profile->buckets[bucket] = i;
+    }
+    
+    return profile;
+}
+
+void free_profile(Profile* profile) {
+    if (profile == NULL) return;
+    
+    for (int i = 0; i < profile->entry_count; i++) {
+        free(profile->entries[i].counts);
+    }
+    free(profile->entries);
+    free(profile->buckets);
+    free(profile);
+}
+
+const ProfileEntry* find_profile_entry(const Profile* profile, const Node* node) {
+    size_t bucket = hash_node(node, profile->bucket_count);
+    
+    while (profile->buckets[bucket] != -1) {
+        const ProfileEntry* entry = &profile->entries[profile->buckets[bucket]];
+        if (entry->node == node) return entry;
+        bucket = (bucket + 1) & (size_t)(profile->bucket_count - 1);
+    }
+    
+    return NULL;
+}
+
+void profile_count(Profile* profile, const Node* node, int arm) {
+    const ProfileEntry* entry = find_profile_entry(profile, node);
+    
+    if (entry != NULL && arm >= 0 && arm < entry->count_size) {
+        __atomic_fetch_add(&entry->counts[arm], 1, __ATOMIC_RELAXED);
+    }
+}
+
+int write_profile(const Profile* profile, const char* path, char* error, size_t error_size) {
+    FILE* file = fopen(path, "w");
+    if (file == NULL) {
+        snprintf(error, error_size, "Erro: não foi possível criar o perfil '%s'", path);
+        return 1;
+    }
+    
+    fprintf(file, "TechFlow profile %d\n", PROFILE_VERSION);
+    for (int i = 0; i < profile->entry_count; i++) {
+        const ProfileEntry* entry = &profile->entries[i];
+        fprintf(file, "%d %s %d", i, profile_kind(entry->node), entry->count_size);
+        for (int k = 0; k < entry->count_size; k++) {
+            fprintf(file, " %" PRIu64, entry->counts[k]);
+        }
+        fprintf(file, "\n");
+    }
+    
+    if (fclose(file) != 0) {
+        snprintf(error, error_size, "Erro ao escrever o perfil '%s'", path);
+        return 1;
+    }
+    return 0;
+}
+
+Profile* load_profile(Node* root, const char* path, char* error, size_t error_size) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        snprintf(error, error_size, "Erro: não foi possível abrir o perfil '%s'", path);
+        return NULL;
+    }
+    
+    Profile* profile = create_profile(root);
+    int version = 0;
+    
+    if (fscanf(file, "TechFlow profile %d", &version) != 1 || version != PROFILE_VERSION) {
+        snprintf(error, error_size, "Erro: '%s' não é um perfil TechFlow válido", path);
+        fclose(file);
+        free_profile(profile);
+        return NULL;
+    }
+    
+    int index, count_size;
+    char kind[16];
+    int loaded = 0;
+    int matches = 1;
+    
+    while (matches && fscanf(file, "%d %15s %d", &index, kind, &count_size) == 3) {
+        if (index != loaded || index >= profile->entry_count ||
+            strcmp(kind, profile_kind(profile->entries[index].node)) != 0 ||
+            count_size != profile->entries[index].count_size) {
+            matches = 0;
+            break;
+        }
+        
+        int k = 0;
+        while (k < count_size && fscanf(file, "%" SCNu64, &profile->entries[index].counts[k]) == 1) {
+            k++;
+        }
+        if (k != count_size) matches = 0;
+        loaded++;
+    }
+    
+    fclose(file);
+    
+    if (!matches || loaded != profile->entry_count) {
+        snprintf(error, error_size, "Erro: o perfil '%s' não corresponde ao programa", path);
+        free_profile(profile);
+        return NULL;
+    }
+    
+    return profile;
+}
@@ -0,0 +1,24 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "llvm_generator.h"
+
+#define PROFILE_VERSION 1
+
+typedef struct {
+    const Node* node;
+    int count_size;
+    uint64_t* counts;
+} ProfileEntry;
+
+Profile* create_profile(Node* root);
+Profile* load_profile(Node* root, const char* path, char* error, size_t error_size);
+int write_profile(const Profile* profile, const char* path, char* error, size_t error_size);
+void free_profile(Profile* profile);
+
+const ProfileEntry* find_profile_entry(const Profile* profile, const Node* node);
+void profile_count(Profile* profile, const Node* node, int arm);
+
+#endif
@@ -0,0 +1,541 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "program_image.h"
+
+typedef struct {
+    unsigned char* data;
+    size_t size;
+    size_t capacity;
+    uint64_t* relocations;
+    size_t relocation_count;
+    size_t relocation_capacity;
+} ImageWriter;
+
+static uint64_t image_reserve(ImageWriter* writer, size_t size) {
+    size_t offset = (writer->size + 7) & ~(size_t)7;
+    size_t end = offset + size;
+    
+    if (end > writer->capacity) {
+        size_t capacity = writer->capacity == 0 ? 4096 : writer->capacity;
+        while (capacity < end) capacity *= 2;
+        
+        unsigned char* data = (unsigned char*)realloc(writer->data, capacity);
+        if (data == NULL) {
+            fprintf(stderr, "Erro: Falha na alocação de memória\n");
+            exit(1);
+        }
+        
+        writer->data = data;
+        writer->capacity = capacity;
+    }
+    
+    memset(writer->data + writer->size, 0, end - writer->size);
+    writer->size = end;
+    return offset;
+}
+
+static void image_set_pointer(ImageWriter* writer, uint64_t field_offset, uint64_t target) {
+    memcpy(writer->data + field_offset, &target, sizeof(uint64_t));
+    
+    if (target == 0) return;
+    
+    if (writer->relocation_count >= writer->relocation_capacity) {
+        size_t capacity = writer->relocation_capacity == 0 ? 256 : writer->relocation_capacity * 2;
+        uint64_t* relocations = (uint64_t*)realloc(writer->relocations, capacity * sizeof(uint64_t));
+        if (relocations == NULL) {
+            fprintf(stderr, "Erro: Falha na alocação de memória\n");
+            exit(1);
+        }
+        
+        writer->relocations = relocations;
+        writer->relocation_capacity = capacity;
+    }
+    
+    writer->relocations[writer->relocation_count++] = field_offset;
+}
+
+static uint64_t image_write_string(ImageWriter* writer, const char* str) {
+    if (str == NULL) return 0;
+    
+    size_t length = strlen(str) + 1;
+    uint64_t offset = image_reserve(writer, length);
+    memcpy(writer->data + offset, str, length);
+    return offset;
+}
+
+#define FIELD(offset, field) ((offset) + offsetof(Node, field))
+
+static uint64_t image_write_node(ImageWriter* writer, Node* node);
+
+static uint64_t image_write_node_array(ImageWriter* writer, Node** nodes, int count) {
+    if (count == 0) return 0;
+    
+    uint64_t offset = image_reserve(writer, count * sizeof(uint64_t));
+    for (int i = 0; i < count; i++) {
+        uint64_t child = image_write_node(writer, nodes[i]);
+        image_set_pointer(writer, offset + i * sizeof(uint64_t), child);
+    }
+    return offset;
+}
+
+static uint64_t image_write_string_array(ImageWriter* writer, char** strings, int count) {
+    if (count == 0) return 0;
+    
+    uint64_t offset = image_reserve(writer, count * sizeof(uint64_t));
+    for (int i = 0; i < count; i++) {
+        uint64_t str = image_write_string(writer, strings[i]);
+        image_set_pointer(writer, offset + i * sizeof(uint64_t), str);
+    }
+    return offset;
+}
+
+static uint64_t image_write_node(ImageWriter* writer, Node* node) {
+    if (node == NULL) return 0;
+    
+    uint64_t offset = image_reserve(writer, sizeof(Node));
+    Node copy = *node;
+    copy.next = NULL;
+    memcpy(writer->data + offset, &copy, sizeof(Node));
+    
+    switch (node->type) {
+        case NODE_PROGRAM:
+            image_set_pointer(writer, FIELD(offset, data.program.body),
+                              image_write_node(writer, node->data.program.body));
+            break;
+        case NODE_BLOCK:
+            image_set_pointer(writer, FIELD(offset, data.block.statements),
+                              image_write_node_array(writer, node->data.block.statements, node->data.block.stmt_count));
+            break;
+        case NODE_VAR_DECL:
+            image_set_pointer(writer, FIELD(offset, data.var_decl.name),
+                              image_write_string(writer, node->data.var_decl.name));
+            image_set_pointer(writer, FIELD(offset, data.var_decl.data_type),
+                              image_write_string(writer, node->data.var_decl.data_type));
+            image_set_pointer(writer, FIELD(offset, data.var_decl.init_expr),
+                              image_write_node(writer, node->data.var_decl.init_expr));
+            break;
+        case NODE_ASSIGN:
+            image_set_pointer(writer, FIELD(offset, data.assign.name),
+                              image_write_string(writer, node->data.assign.name));
+            image_set_pointer(writer, FIELD(offset, data.assign.value),
+                              image_write_node(writer, node->data.assign.value));
+            break;
+        case NODE_IF:
+            image_set_pointer(writer, FIELD(offset, data.if_stmt.condition),
+                              image_write_node(writer, node->data.if_stmt.condition));
+            image_set_pointer(writer, FIELD(offset, data.if_stmt.then_branch),
+                              image_write_node(writer, node->data.if_stmt.then_branch));
+            image_set_pointer(writer, FIELD(offset, data.if_stmt.else_branch),
+                              image_write_node(writer, node->data.if_stmt.else_branch));
+            break;
+        case NODE_WHILE:
+            image_set_pointer(writer, FIELD(offset, data.while_stmt.condition),
+                              image_write_node(writer, node->data.while_stmt.condition));
+            image_set_pointer(writer, FIELD(offset, data.while_stmt.body),
+                              image_write_node(writer, node->data.while_stmt.body));
+            break;
+        case NODE_REPEAT:
+            image_set_pointer(writer, FIELD(offset, data.repeat_stmt.body),
+                              image_write_node(writer, node->data.repeat_stmt.body));
+            image_set_pointer(writer, FIELD(offset, data.repeat_stmt.condition),
+                              image_write_node(writer, node->data.repeat_stmt.condition));
+            break;
+        case NODE_PARALLEL_FOR:
+            image_set_pointer(writer, FIELD(offset, data.parallel_for.var_name),
+                              image_write_string(writer, node->data.parallel_for.var_name));
+            image_set_pointer(writer, FIELD(offset, data.parallel_for.start),
+                              image_write_node(writer, node->data.parallel_for.start));
+            image_set_pointer(writer, FIELD(offset, data.parallel_for.end),
+                              image_write_node(writer, node->data.parallel_for.end));
+            image_set_pointer(writer, FIELD(offset, data.parallel_for.body),
+                              image_write_node(writer, node->data.parallel_for.body));
+            image_set_pointer(writer, FIELD(offset, data.parallel_for.reduce_ops),
+                              image_write_string_array(writer, node->data.parallel_for.reduce_ops,
+                                                       node->data.parallel_for.reduce_count));
+            image_set_pointer(writer, FIELD(offset, data.parallel_for.reduce_vars),
+                              image_write_string_array(writer, node->data.parallel_for.reduce_vars,
+                                                       node->data.parallel_for.reduce_count));
+            break;
+        case NODE_SWITCH:
+            image_set_pointer(writer, FIELD(offset, data.switch_stmt.condition),
+                              image_write_node(writer, node->data.switch_stmt.condition));
+            image_set_pointer(writer, FIELD(offset, data.switch_stmt.cases),
+                              image_write_node_array(writer, node->data.switch_stmt.cases, node->data.switch_stmt.case_count));
+            image_set_pointer(writer, FIELD(offset, data.switch_stmt.default_case),
+                              image_write_node(writer, node->data.switch_stmt.default_case));
+            break;
+        case NODE_CASE:
+            image_set_pointer(writer, FIELD(offset, data.case_stmt.value),
+                              image_write_node(writer, node->data.case_stmt.value));
+            image_set_pointer(writer, FIELD(offset, data.case_stmt.body),
+                              image_write_node(writer, node->data.case_stmt.body));
+            break;
+        case NODE_PRINT:
+            image_set_pointer(writer, FIELD(offset, data.print_stmt.expr),
+                              image_write_node(writer, node->data.print_stmt.expr));
+            break;
+        case NODE_BINARY_OP:
+            image_set_pointer(writer, FIELD(offset, data.binary_op.operator),
+                              image_write_string(writer, node->data.binary_op.operator));
+            image_set_pointer(writer, FIELD(offset, data.binary_op.left),
+                              image_write_node(writer, node->data.binary_op.left));
+            image_set_pointer(writer, FIELD(offset, data.binary_op.right),
+                              image_write_node(writer, node->data.binary_op.right));
+            break;
+        case NODE_UNARY_OP:
+            image_set_pointer(writer, FIELD(offset, data.unary_op.operator),
+                              image_write_string(writer, node->data.unary_op.operator));
+            image_set_pointer(writer, FIELD(offset, data.unary_op.operand),
+                              image_write_node(writer, node->data.unary_op.operand));
+            break;
+        case NODE_STRING_VAL:
+        case NODE_IDENTIFIER:
+            image_set_pointer(writer, FIELD(offset, data.str_value),
+                              image_write_string(writer, node->data.str_value));
+            break;
+        case NODE_READ:
+            image_set_pointer(writer, FIELD(offset, data.read_expr.data_type),
+                              image_write_string(writer, node->data.read_expr.data_type));
+            break;
+        case NODE_SPAWN:
+            image_set_pointer(writer, FIELD(offset, data.spawn.body),
+                              image_write_node(writer, node->data.spawn.body));
+            break;
+        case NODE_CHANNEL_DECL:
+            image_set_pointer(writer, FIELD(offset, data.channel_decl.name),
+                              image_write_string(writer, node->data.channel_decl.name));
+            image_set_pointer(writer, FIELD(offset, data.channel_decl.data_type),
+                              image_write_string(writer, node->data.channel_decl.data_type));
+            image_set_pointer(writer, FIELD(offset, data.channel_decl.capacity),
+                              image_write_node(writer, node->data.channel_decl.capacity));
+            break;
+        case NODE_SEND:
+        case NODE_RECEIVE:
+        case NODE_CLOSE:
+            image_set_pointer(writer, FIELD(offset, data.channel_op.channel),
+                              image_write_string(writer, node->data.channel_op.channel));
+            image_set_pointer(writer, FIELD(offset, data.channel_op.value),
+                              image_write_node(writer, node->data.channel_op.value));
+            break;
+        case NODE_RECEIVE_LOOP:
+            image_set_pointer(writer, FIELD(offset, data.receive_loop.var_name),
+                              image_write_string(writer, node->data.receive_loop.var_name));
+            image_set_pointer(writer, FIELD(offset, data.receive_loop.channel),
+                              image_write_string(writer, node->data.receive_loop.channel));
+            image_set_pointer(writer, FIELD(offset, data.receive_loop.body),
+                              image_write_node(writer, node->data.receive_loop.body));
+            break;
+        default:
+            break;
+    }
+    
+    return offset;
+}
+
+typedef enum {
+    IMAGE_NODE_PROGRAM,
+    IMAGE_NODE_BLOCK,
+    IMAGE_NODE_STATEMENT,
+    IMAGE_NODE_EXPRESSION,
+    IMAGE_NODE_CASE
+} ImageNodeKind;
+
+typedef struct {
+    const unsigned char* data;
+    size_t size;
+    size_t remaining_nodes;
+} ImageValidator;
+
+static bool image_contains(const ImageValidator* validator, const void* ptr, size_t length) {
+    uintptr_t start = (uintptr_t)validator->data;
+    uintptr_t address = (uintptr_t)ptr;
+    
+    return address >= start && address - start <= validator->size &&
+           length <= validator->size - (address - start) && (address - start) % sizeof(uint64_t) == 0;
+}
+
+static bool image_node_kind_matches(NodeType type, ImageNodeKind kind) {
+    switch (type) {
+        case NODE_PROGRAM:
+            return kind == IMAGE_NODE_PROGRAM;
+        case NODE_BLOCK:
+            return kind == IMAGE_NODE_BLOCK;
+        case NODE_CASE:
+            return kind == IMAGE_NODE_CASE;
+        case NODE_INT_VAL:
+        case NODE_STRING_VAL:
+        case NODE_BOOL_VAL:
+        case NODE_IDENTIFIER:
+        case NODE_READ:
+        case NODE_BINARY_OP:
+        case NODE_UNARY_OP:
+        case NODE_RECEIVE:
+            return kind == IMAGE_NODE_EXPRESSION || kind == IMAGE_NODE_STATEMENT;
+        case NODE_VAR_DECL:
+        case NODE_ASSIGN:
+        case NODE_IF:
+        case NODE_WHILE:
+        case NODE_REPEAT:
+        case NODE_SWITCH:
+        case NODE_PRINT:
+        case NODE_PARALLEL_FOR:
+        case NODE_SPAWN:
+        case NODE_CHANNEL_DECL:
+        case NODE_SEND:
+        case NODE_CLOSE:
+        case NODE_RECEIVE_LOOP:
+            return kind == IMAGE_NODE_STATEMENT;
+        default:
+            return false;
+    }
+}
+
+static bool validate_image_string(const ImageValidator* validator, const char* str) {
+    uintptr_t start = (uintptr_t)validator->data;
+    uintptr_t address = (uintptr_t)str;
+    
+    return str != NULL && address >= start && address - start < validator->size &&
+           memchr(str, '\0', validator->size - (address - start)) != NULL;
+}
+
+static bool validate_image_node(ImageValidator* validator, const Node* node, ImageNodeKind kind, bool optional);
+
+static bool validate_image_node_array(ImageValidator* validator, Node* const* nodes, int count, ImageNodeKind kind) {
+    if (count == 0) return nodes == NULL;
+    if (count < 0 || !image_contains(validator, nodes, (size_t)count * sizeof(Node*))) return false;
+    
+    for (int i = 0; i < count; i++) {
+        if (!validate_image_node(validator, nodes[i], kind, false)) return false;
+    }
+    return true;
+}
+
+static bool validate_image_string_array(const ImageValidator* validator, char* const* strings, int count) {
+    if (count == 0) return strings == NULL;
+    if (count < 0 || !image_contains(validator, strings, (size_t)count * sizeof(char*))) return false;
+    
+    for (int i = 0; i < count; i++) {
+        if (!validate_image_string(validator, strings[i])) return false;
+    }
+    return true;
+}
+
+static bool validate_image_node(ImageValidator* validator, const Node* node, ImageNodeKind kind, bool optional) {
+    if (node == NULL) return optional;
+    
+    if (validator->remaining_nodes == 0 || !image_contains(validator, node, sizeof(Node)) ||
+        node->next != NULL || !image_node_kind_matches(node->type, kind)) {
+        return false;
+    }
+    validator->remaining_nodes--;
+    
+    switch (node->type) {
+        case NODE_PROGRAM:
+            return validate_image_node(validator, node->data.program.body, IMAGE_NODE_BLOCK, false);
+        case NODE_BLOCK:
+            return validate_image_node_array(validator, node->data.block.statements, node->data.block.stmt_count,
+                                             IMAGE_NODE_STATEMENT);
+        case NODE_VAR_DECL:
+            return validate_image_string(validator, node->data.var_decl.name) &&
+                   validate_image_string(validator, node->data.var_decl.data_type) &&
+                   validate_image_node(validator, node->data.var_decl.init_expr, IMAGE_NODE_EXPRESSION, true);
+        case NODE_ASSIGN:
+            return validate_image_string(validator, node->data.assign.name) &&
+                   validate_image_node(validator, node->data.assign.value, IMAGE_NODE_EXPRESSION, false);
+        case NODE_IF:
+            return validate_image_node(validator, node->data.if_stmt.condition, IMAGE_NODE_EXPRESSION, false) &&
+                   validate_image_node(validator, node->data.if_stmt.then_branch, IMAGE_NODE_BLOCK, false) &&
+                   validate_image_node(validator, node->data.if_stmt.else_branch, IMAGE_NODE_BLOCK, true);
+        case NODE_WHILE:
+            return validate_image_node(validator, node->data.while_stmt.condition, IMAGE_NODE_EXPRESSION, false) &&
+                   validate_image_node(validator, node->data.while_stmt.body, IMAGE_NODE_BLOCK, false);
+        case NODE_REPEAT:
+            return validate_image_node(validator, node->data.repeat_stmt.body, IMAGE_NODE_BLOCK, false) &&
+                   validate_image_node(validator, node->data.repeat_stmt.condition, IMAGE_NODE_EXPRESSION, false);
+        case NODE_PARALLEL_FOR:
+            return validate_image_string(validator, node->data.parallel_for.var_name) &&
+                   validate_image_node(validator, node->data.parallel_for.start, IMAGE_NODE_EXPRESSION, false) &&
+                   validate_image_node(validator, node->data.parallel_for.end, IMAGE_NODE_EXPRESSION, false) &&
+                   validate_image_node(validator, node->data.parallel_for.body, IMAGE_NODE_BLOCK, false) &&
+                   validate_image_string_array(validator, node->data.parallel_for.reduce_ops,
+                                               node->data.parallel_for.reduce_count) &&
+                   validate_image_string_array(validator, node->data.parallel_for.reduce_vars,
+                                               node->data.parallel_for.reduce_count);
+        case NODE_SWITCH:
+            return validate_image_node(validator, node->data.switch_stmt.condition, IMAGE_NODE_EXPRESSION, false) &&
+                   validate_image_node_array(validator, node->data.switch_stmt.cases, node->data.switch_stmt.case_count,
+                                             IMAGE_NODE_CASE) &&
+                   validate_image_node(validator, node->data.switch_stmt.default_case, IMAGE_NODE_BLOCK, true);
+        case NODE_CASE:
+            return validate_image_node(validator, node->data.case_stmt.value, IMAGE_NODE_EXPRESSION, false) &&
+                   validate_image_node(validator, node->data.case_stmt.body, IMAGE_NODE_BLOCK, false);
+        case NODE_PRINT:
+            return validate_image_node(validator, node->data.print_stmt.expr, IMAGE_NODE_EXPRESSION, false);
+        case NODE_BINARY_OP:
+            return validate_image_string(validator, node->data.binary_op.operator) &&
+                   validate_image_node(validator, node->data.binary_op.left, IMAGE_NODE_EXPRESSION, false) &&
+                   validate_image_node(validator, node->data.binary_op.right, IMAGE_NODE_EXPRESSION, false);
+        case NODE_UNARY_OP:
+            return validate_image_string(validator, node->data.unary_op.operator) &&
+                   validate_image_node(validator, node->data.unary_op.operand, IMAGE_NODE_EXPRESSION, false);
+        case NODE_STRING_VAL:
+        case NODE_IDENTIFIER:
+            return validate_image_string(validator, node->data.str_value);
+        case NODE_READ:
+            return validate_image_string(validator, node->data.read_expr.data_type);
+        case NODE_SPAWN:
+            return validate_image_node(validator, node->data.spawn.body, IMAGE_NODE_BLOCK, false);
+        case NODE_CHANNEL_DECL:
+            return validate_image_string(validator, node->data.channel_decl.name) &&
+                   validate_image_string(validator, node->data.channel_decl.data_type) &&
+                   validate_image_node(validator, node->data.channel_decl.capacity, IMAGE_NODE_EXPRESSION, true);
+        case NODE_SEND:
+        case NODE_RECEIVE:
+        case NODE_CLOSE:
+            return validate_image_string(validator, node->data.channel_op.channel) &&
+                   validate_image_node(validator, node->data.channel_op.value, IMAGE_NODE_EXPRESSION,
+                                       node->type != NODE_SEND);
+        case NODE_RECEIVE_LOOP:
+            return validate_image_string(validator, node->data.receive_loop.var_name) &&
+                   validate_image_string(validator, node->data.receive_loop.channel) &&
+                   validate_image_node(validator, node->data.receive_loop.body, IMAGE_NODE_BLOCK, false);
+        default:
+            return true;
+    }
+}
+
+int is_program_image(const char* path) {
+    char magic[4];
+    FILE* file = fopen(path, "rb");
+    
+    if (file == NULL) return 0;
+    
+    int matches = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                  memcmp(magic, PROGRAM_IMAGE_MAGIC, sizeof(magic)) == 0;
+    fclose(file);
+    return matches;
+}
+
+int write_program_image(Node* root, const char* path, char* error, size_t error_size) {
+    ImageWriter writer = { 0 };
+    
+    uint64_t header_offset = image_reserve(&writer, sizeof(ProgramImageHeader));
+    uint64_t root_offset = image_write_node(&writer, root);
+    uint64_t relocation_offset = image_reserve(&writer, writer.relocation_count * sizeof(uint64_t));
+    memcpy(writer.data + relocation_offset, writer.relocations, writer.relocation_count * sizeof(uint64_t));
+    
+    ProgramImageHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PROGRAM_IMAGE_MAGIC, sizeof(header.magic));
+    header.version = PROGRAM_IMAGE_VERSION;
+    header.node_size = sizeof(Node);
+    header.pointer_size = sizeof(void*);
+    header.image_size = writer.size;
+    header.root_offset = root_offset;
+    header.relocation_offset = relocation_offset;
+    header.relocation_count = writer.relocation_count;
+    memcpy(writer.data + header_offset, &header, sizeof(header));
+    
+    int status = 0;
+    FILE* file = fopen(path, "wb");
+    if (file == NULL || fwrite(writer.data, 1, writer.size, file) != writer.size) {
+        snprintf(error, error_size, "Erro: não foi possível escrever o arquivo '%s'", path);
+        status = 1;
+    }
+    if (file != NULL && fclose(file) != 0 && status == 0) {
+        snprintf(error, error_size, "Erro: não foi possível escrever o arquivo '%s'", path);
+        status = 1;
+    }
+    
+    free(writer.data);
+    free(writer.relocations);
+    return status;
+}
+
+Node* load_program_image(const char* path, ProgramImage* image, char* error, size_t error_size) {
+    image->data = NULL;
+    image->size = 0;
+    
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        snprintf(error, error_size, "Erro: não foi possível abrir o arquivo '%s'", path);
+        return NULL;
+    }
+    
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(ProgramImageHeader)) {
+        snprintf(error, error_size, "Erro: arquivo pré-compilado '%s' inválido", path);
+        close(fd);
+        return NULL;
+    }
+    
+    size_t size = (size_t)st.st_size;
+    unsigned char* data = (unsigned char*)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    
+    if (data == MAP_FAILED) {
+        snprintf(error, error_size, "Erro: não foi possível mapear o arquivo '%s'", path);
+        return NULL;
+    }
+    
+    const ProgramImageHeader* header = (const ProgramImageHeader*)data;
+    if (memcmp(header->magic, PROGRAM_IMAGE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != PROGRAM_IMAGE_VERSION ||
+        header->node_size != sizeof(Node) ||
+        header->pointer_size != sizeof(void*) ||
+        header->image_size != size ||
+        header->root_offset + sizeof(Node) > size ||
+        header->relocation_count > size / sizeof(uint64_t) ||
+        header->relocation_offset + header->relocation_count * sizeof(uint64_t) > size) {
+        snprintf(error, error_size, "Erro: arquivo pré-compilado '%s' incompatível com esta versão", path);
+        munmap(data, size);
+        return NULL;
+    }
+    
+    const uint64_t* relocations = (const uint64_t*)(data + header->relocation_offset);
+    for (uint64_t i = 0; i < header->relocation_count; i++) {
+        uint64_t field = relocations[i];
+        uint64_t target;
+        
+        if (field + sizeof(uint64_t) > size) {
+            snprintf(error, error_size, "Erro: arquivo pré-compilado '%s' corrompido", path);
+            munmap(data, size);
+            return NULL;
+        }
+        
+        memcpy(&target, data + field, sizeof(uint64_t));
+        if (target == 0 || target >= size) {
+            snprintf(error, error_size, "Erro: arquivo pré-compilado '%s' corrompido", path);
+            munmap(data, size);
+            return NULL;
+        }
+        
+        uintptr_t address = (uintptr_t)(data + target);
+        memcpy(data + field, &address, sizeof(uintptr_t));
+    }
+    
+    ImageValidator validator = { data, size, size / sizeof(Node) };
+    if (!validate_image_node(&validator, (const Node*)(data + header->root_offset), IMAGE_NODE_PROGRAM, false)) {
+        snprintf(error, error_size, "Erro: arquivo pré-compilado '%s' corrompido", path);
+        munmap(data, size);
+        return NULL;
+    }
+    
+    image->data = data;
+    image->size = size;
+    return (Node*)(data + header->root_offset);
+}
+
+void unload_program_image(ProgramImage* image) {
+    if (image->data != NULL) {
+        munmap(image->data, image->size);
+        image->data = NULL;
+        image->size = 0;
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef PROGRAM_IMAGE_H
+#define PROGRAM_IMAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "llvm_generator.h"
+
+#define PROGRAM_IMAGE_MAGIC "TFC\0"
+#define PROGRAM_IMAGE_VERSION 3
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t node_size;
+    uint32_t pointer_size;
+    uint64_t image_size;
+    uint64_t root_offset;
+    uint64_t relocation_offset;
+    uint64_t relocation_count;
+} ProgramImageHeader;
+
+typedef struct {
+    void* data;
+    size_t size;
+} ProgramImage;
+
+int is_program_image(const char* path);
+int write_program_image(Node* root, const char* path, char* error, size_t error_size);
+Node* load_program_image(const char* path, ProgramImage* image, char* error, size_t error_size);
+void unload_program_image(ProgramImage* image);
+
+#endif
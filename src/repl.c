@@ -0,0 +1,134 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <unistd.h>
+#include "llvm_generator.h"
+#include "llvm_backend.h"
+#include "runtime_support.h"
+#include "repl.h"
+
+#define REPL_PROMPT "tf> "
+#define REPL_CONTINUATION_PROMPT "... "
+
+Node* parse_statements(FILE* input, bool* incomplete, char* error, size_t error_size);
+void free_ast(Node* node);
+
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+} ReplBuffer;
+
+static void append_line(ReplBuffer* buffer, const char* line, size_t length) {
+    if (buffer->length + length + 2 > buffer->capacity) {
+        size_t capacity = buffer->capacity == 0 ? 256 : buffer->capacity;
+        while (capacity < buffer->length + length + 2) capacity *= 2;
+        
+        buffer->data = (char*)realloc(buffer->data, capacity);
+        if (buffer->data == NULL) {
+            fprintf(stderr, "Erro: Falha na alocação de memória\n");
+            exit(1);
+        }
+        buffer->capacity = capacity;
+    }
+    
+    memcpy(buffer->data + buffer->length, line, length);
+    buffer->length += length;
+    buffer->data[buffer->length++] = '\n';
+    buffer->data[buffer->length] = '\0';
+}
+
+static bool is_blank(const ReplBuffer* buffer) {
+    for (size_t i = 0; i < buffer->length; i++) {
+        if (!isspace((unsigned char)buffer->data[i])) return false;
+    }
+    return true;
+}
+
+static int execute_entry(const LLVMBackend* backend, ReplSession* session, ReplBuffer* pending, bool* incomplete) {
+    char error[512];
+    FILE* input = fmemopen(pending->data, pending->length, "r");
+    
+    if (input == NULL) {
+        fprintf(stderr, "Erro: não foi possível ler a entrada\n");
+        return 1;
+    }
+    
+    Node* statements = parse_statements(input, incomplete, error, sizeof(error));
+    fclose(input);
+    
+    if (statements == NULL) {
+        if (*incomplete) return 0;
+        
+        fprintf(stderr, "%s\n", error);
+        return 1;
+    }
+    
+    int status = backend->execute_repl_statements(session, statements);
+    free_ast(statements);
+    tf_output_flush();
+    return status;
+}
+
+int run_repl(void) {
+    char error[512];
+    const LLVMBackend* backend = load_llvm_backend(error, sizeof(error));
+    if (backend == NULL) {
+        fprintf(stderr, "%s\n", error);
+        return 1;
+    }
+    
+    ReplSession* session = backend->create_repl_session(error, sizeof(error));
+    if (session == NULL) {
+        fprintf(stderr, "%s\n", error);
+        return 1;
+    }
+    
+    bool interactive = isatty(STDIN_FILENO);
+    ReplBuffer pending = { NULL, 0, 0 };
+    int status = 0;
+    
+    if (interactive) {
+        printf("TechFlow REPL: cada instrução é compilada e executada ao ser digitada (Ctrl-D encerra)\n");
+    }
+    
+    for (;;) {
+        if (interactive) {
+            fputs(pending.length == 0 ? REPL_PROMPT : REPL_CONTINUATION_PROMPT, stdout);
+            fflush(stdout);
+        }
+        
+        const char* line;
+        size_t length;
+        if (!tf_stdin_read_line(&line, &length)) break;
+        
+        append_line(&pending, line, length);
+        if (is_blank(&pending)) {
+            pending.length = 0;
+            continue;
+        }
+        
+        bool incomplete = false;
+        if (execute_entry(backend, session, &pending, &incomplete) != 0) {
+            status = 1;
+        }
+        if (!incomplete) {
+            pending.length = 0;
+        }
+    }
+    
+    if (interactive) {
+        putchar('\n');
+    }
+    
+    if (pending.length > 0) {
+        fprintf(stderr, "Erro: entrada incompleta ao final da sessão\n");
+        status = 1;
+    }
+    
+    backend->free_repl_session(session);
+    free(pending.data);
+    return status;
+}
@@ -0,0 +1,6 @@
+#ifndef REPL_H
+#define REPL_H
+
+int run_repl(void);
+
+#endif
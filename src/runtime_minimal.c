@@ -0,0 +1,550 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__x86_64__)
+#define TF_SYS_READ 0
+#define TF_SYS_WRITE 1
+#define TF_SYS_MMAP 9
+#define TF_SYS_IOCTL 16
+#define TF_SYS_CLOCK_GETTIME 228
+#define TF_SYS_EXIT_GROUP 231
+#elif defined(__aarch64__)
+#define TF_SYS_IOCTL 29
+#define TF_SYS_READ 63
+#define TF_SYS_WRITE 64
+#define TF_SYS_EXIT_GROUP 94
+#define TF_SYS_CLOCK_GETTIME 113
+#define TF_SYS_MMAP 222
+#else
+#error "runtime mínimo disponível apenas para Linux x86_64 e aarch64"
+#endif
+
+#define TF_PROT_READ 0x1
+#define TF_PROT_WRITE 0x2
+#define TF_MAP_PRIVATE 0x02
+#define TF_MAP_ANONYMOUS 0x20
+#define TF_TCGETS 0x5401
+#define TF_CLOCK_MONOTONIC 1
+
+#define TF_ARENA_SIZE (1 << 20)
+#define TF_OUTPUT_BUFFER_SIZE (1 << 16)
+#define TF_READER_BUFFER_SIZE (1 << 16)
+#define TF_BUDGET_SLICE 1024
+
+static long tf_syscall6(long number, long a, long b, long c, long d, long e, long f) {
+#if defined(__x86_64__)
+    long result;
+    register long r10 __asm__("r10") = d;
+    register long r8 __asm__("r8") = e;
+    register long r9 __asm__("r9") = f;
+    
+    __asm__ volatile ("syscall"
+                      : "=a"(result)
+                      : "a"(number), "D"(a), "S"(b), "d"(c), "r"(r10), "r"(r8), "r"(r9)
+                      : "rcx", "r11", "memory");
+    return result;
+#else
+    register long x8 __asm__("x8") = number;
+    register long x0 __asm__("x0") = a;
+    register long x1 __asm__("x1") = b;
+    register long x2 __asm__("x2") = c;
+    register long x3 __asm__("x3") = d;
+    register long x4 __asm__("x4") = e;
+    register long x5 __asm__("x5") = f;
+    
+    __asm__ volatile ("svc 0"
+                      : "+r"(x0)
+                      : "r"(x8), "r"(x1), "r"(x2), "r"(x3), "r"(x4), "r"(x5)
+                      : "memory");
+    return x0;
+#endif
+}
+
+static long tf_syscall3(long number, long a, long b, long c) {
+    return tf_syscall6(number, a, b, c, 0, 0, 0);
+}
+
+void* memcpy(void* dest, const void* src, size_t n) {
+    unsigned char* d = (unsigned char*)dest;
+    const unsigned char* s = (const unsigned char*)src;
+    
+    while (n-- > 0) *d++ = *s++;
+    return dest;
+}
+
+void* memmove(void* dest, const void* src, size_t n) {
+    unsigned char* d = (unsigned char*)dest;
+    const unsigned char* s = (const unsigned char*)src;
+    
+    if (d < s) {
+        while (n-- > 0) *d++ = *s++;
+    } else {
+        while (n-- > 0) d[n] = s[n];
+    }
+    return dest;
+}
+
+void* memset(void* dest, int c, size_t n) {
+    unsigned char* d = (unsigned char*)dest;
+    
+    while (n-- > 0) *d++ = (unsigned char)c;
+    return dest;
+}
+
+int memcmp(const void* a, const void* b, size_t n) {
+    const unsigned char* x = (const unsigned char*)a;
+    const unsigned char* y = (const unsigned char*)b;
+    
+    for (size_t i = 0; i < n; i++) {
+        if (x[i] != y[i]) return x[i] < y[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+static __attribute__((noreturn)) void tf_exit(int status) {
+    for (;;) {
+        tf_syscall3(TF_SYS_EXIT_GROUP, status, 0, 0);
+    }
+}
+
+static void tf_write_fd(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        long written = tf_syscall3(TF_SYS_WRITE, fd, (long)data, (long)length);
+        if (written == -4) continue;
+        if (written <= 0) return;
+        data += written;
+        length -= (size_t)written;
+    }
+}
+
+static size_t tf_cstring_length(const char* str) {
+    size_t length = 0;
+    
+    while (str[length] != '\0') length++;
+    return length;
+}
+
+static char* tf_format_u64(uint64_t value, char* end) {
+    do {
+        *--end = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    return end;
+}
+
+static struct {
+    int line_mode;
+    int initialized;
+    size_t used;
+    char buffer[TF_OUTPUT_BUFFER_SIZE];
+} tf_output;
+
+static const char* tf_output_env = NULL;
+
+static void tf_output_init(void) {
+    char termios[64];
+    
+    tf_output.initialized = 1;
+    
+    if (tf_output_env != NULL) {
+        tf_output.line_mode = tf_output_env[0] == 'l' && tf_output_env[1] == 'i' &&
+                              tf_output_env[2] == 'n' && tf_output_env[3] == 'e' && tf_output_env[4] == '\0';
+        return;
+    }
+    
+    tf_output.line_mode = tf_syscall3(TF_SYS_IOCTL, 1, TF_TCGETS, (long)termios) == 0;
+}
+
+void tf_output_flush(void) {
+    tf_write_fd(1, tf_output.buffer, tf_output.used);
+    tf_output.used = 0;
+}
+
+void tf_output_line(const char* data, size_t length) {
+    if (!tf_output.initialized) {
+        tf_output_init();
+    }
+    
+    if (tf_output.used + length + 1 > TF_OUTPUT_BUFFER_SIZE) {
+        tf_output_flush();
+    }
+    
+    if (length + 1 > TF_OUTPUT_BUFFER_SIZE) {
+        tf_write_fd(1, data, length);
+        tf_write_fd(1, "\n", 1);
+        return;
+    }
+    
+    memcpy(tf_output.buffer + tf_output.used, data, length);
+    tf_output.buffer[tf_output.used + length] = '\n';
+    tf_output.used += length + 1;
+    
+    if (tf_output.line_mode) {
+        tf_output_flush();
+    }
+}
+
+void tf_output_block(const char* data, size_t length) {
+    tf_output_flush();
+    tf_write_fd(1, data, length);
+}
+
+static __attribute__((noreturn)) void tf_fail(const char* message, const char* detail, const char* suffix) {
+    tf_output_flush();
+    tf_write_fd(2, message, tf_cstring_length(message));
+    if (detail != NULL) {
+        tf_write_fd(2, detail, tf_cstring_length(detail));
+        tf_write_fd(2, suffix, tf_cstring_length(suffix));
+    }
+    tf_write_fd(2, "\n", 1);
+    tf_exit(1);
+}
+
+static struct {
+    char* next;
+    size_t available;
+} tf_arena;
+
+static int64_t tf_used_memory = 0;
+
+static void* tf_map(size_t size) {
+    long result = tf_syscall6(TF_SYS_MMAP, 0, (long)size, TF_PROT_READ | TF_PROT_WRITE,
+                              TF_MAP_PRIVATE | TF_MAP_ANONYMOUS, -1, 0);
+    
+    if (result < 0 && result > -4096) {
+        tf_fail("Erro: Falha na alocação de memória", NULL, NULL);
+    }
+    return (void*)result;
+}
+
+static void* tf_alloc(size_t size) {
+    size = (size + 15) & ~(size_t)15;
+    tf_used_memory += (int64_t)size;
+    
+    if (size > TF_ARENA_SIZE / 4) {
+        return tf_map(size);
+    }
+    
+    if (size > tf_arena.available) {
+        tf_arena.next = (char*)tf_map(TF_ARENA_SIZE);
+        tf_arena.available = TF_ARENA_SIZE;
+    }
+    
+    void* result = tf_arena.next;
+    tf_arena.next += size;
+    tf_arena.available -= size;
+    return result;
+}
+
+typedef struct {
+    size_t length;
+    char data[];
+} TFString;
+
+#define TF_STRING_HEADER(str) ((const TFString*)((str) - offsetof(TFString, data)))
+
+static const struct {
+    size_t length;
+    char data[6];
+} tf_true_string = { 4, "true" }, tf_false_string = { 5, "false" };
+
+size_t tf_string_length(const char* str) {
+    return TF_STRING_HEADER(str)->length;
+}
+
+char* tf_string_alloc(size_t length) {
+    TFString* result = (TFString*)tf_alloc(sizeof(TFString) + length + 1);
+    
+    result->length = length;
+    result->data[length] = '\0';
+    return result->data;
+}
+
+int tf_string_equals(const char* str1, const char* str2) {
+    size_t len1 = tf_string_length(str1);
+    
+    if (str1 == str2) return 1;
+    if (len1 != tf_string_length(str2)) return 0;
+    
+    return memcmp(str1, str2, len1) == 0;
+}
+
+int tf_string_compare(const char* str1, const char* str2) {
+    size_t len1 = tf_string_length(str1);
+    size_t len2 = tf_string_length(str2);
+    int diff = memcmp(str1, str2, len1 < len2 ? len1 : len2);
+    
+    if (diff != 0) return diff;
+    return len1 < len2 ? -1 : (len1 > len2 ? 1 : 0);
+}
+
+const char* bool_to_string(int boolean_value) {
+    return boolean_value ? tf_true_string.data : tf_false_string.data;
+}
+
+char* concat_strings(const char* str1, const char* str2) {
+    size_t len1 = tf_string_length(str1);
+    size_t len2 = tf_string_length(str2);
+    char* result = tf_string_alloc(len1 + len2);
+    
+    memcpy(result, str1, len1);
+    memcpy(result + len1, str2, len2);
+    return result;
+}
+
+static char* tf_format_i32(int value, char* end) {
+    unsigned int magnitude = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+    char* start = tf_format_u64(magnitude, end);
+    
+    if (value < 0) {
+        *--start = '-';
+    }
+    return start;
+}
+
+char* int_to_string(int int_value) {
+    char buffer[16];
+    char* end = buffer + sizeof(buffer);
+    char* start = tf_format_i32(int_value, end);
+    char* result = tf_string_alloc((size_t)(end - start));
+    
+    memcpy(result, start, (size_t)(end - start));
+    return result;
+}
+
+void tf_log_i32(int value) {
+    char buffer[16];
+    char* end = buffer + sizeof(buffer);
+    char* start = tf_format_i32(value, end);
+    
+    tf_output_line(start, (size_t)(end - start));
+}
+
+void tf_log_str(const char* str) {
+    tf_output_line(str, tf_string_length(str));
+}
+
+static struct {
+    size_t length;
+    size_t position;
+    int eof;
+    char* line;
+    size_t line_capacity;
+    char buffer[TF_READER_BUFFER_SIZE];
+} tf_reader;
+
+static int tf_reader_peek(void) {
+    if (tf_reader.position < tf_reader.length) {
+        return (unsigned char)tf_reader.buffer[tf_reader.position];
+    }
+    if (tf_reader.eof) return -1;
+    
+    long count;
+    do {
+        count = tf_syscall3(TF_SYS_READ, 0, (long)tf_reader.buffer, TF_READER_BUFFER_SIZE);
+    } while (count == -4);
+    
+    if (count <= 0) {
+        tf_reader.eof = 1;
+        return -1;
+    }
+    
+    tf_reader.length = (size_t)count;
+    tf_reader.position = 0;
+    return (unsigned char)tf_reader.buffer[0];
+}
+
+int tf_read_i32(void) {
+    int c = tf_reader_peek();
+    
+    while (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+        tf_reader.position++;
+        c = tf_reader_peek();
+    }
+    
+    if (c == -1) return 0;
+    
+    int negative = 0;
+    if (c == '-' || c == '+') {
+        negative = c == '-';
+        tf_reader.position++;
+        c = tf_reader_peek();
+    }
+    
+    if (c < '0' || c > '9') {
+        tf_fail("Erro: Valor inválido para reader", NULL, NULL);
+    }
+    
+    long long result = 0;
+    while (c >= '0' && c <= '9') {
+        result = result * 10 + (c - '0');
+        if (result > 2147483648LL) {
+            tf_fail("Erro: Valor fora do intervalo de i32 em reader", NULL, NULL);
+        }
+        tf_reader.position++;
+        c = tf_reader_peek();
+    }
+    
+    if (negative) result = -result;
+    if (result > 2147483647LL) {
+        tf_fail("Erro: Valor fora do intervalo de i32 em reader", NULL, NULL);
+    }
+    
+    while (c == ' ' || c == '\t' || c == '\r') {
+        tf_reader.position++;
+        c = tf_reader_peek();
+    }
+    if (c == '\n') {
+        tf_reader.position++;
+    }
+    
+    return (int)result;
+}
+
+char* tf_read_str(void) {
+    size_t length = 0;
+    
+    while (tf_reader_peek() != -1) {
+        const char* start = tf_reader.buffer + tf_reader.position;
+        size_t available = tf_reader.length - tf_reader.position;
+        size_t chunk = 0;
+        
+        while (chunk < available && start[chunk] != '\n') chunk++;
+        
+        if (length + chunk > tf_reader.line_capacity) {
+            size_t capacity = tf_reader.line_capacity == 0 ? 256 : tf_reader.line_capacity;
+            while (capacity < length + chunk) capacity *= 2;
+            
+            char* line = (char*)tf_alloc(capacity);
+            memcpy(line, tf_reader.line, length);
+            tf_reader.line = line;
+            tf_reader.line_capacity = capacity;
+        }
+        
+        memcpy(tf_reader.line + length, start, chunk);
+        length += chunk;
+        tf_reader.position += chunk;
+        
+        if (chunk < available) {
+            tf_reader.position++;
+            break;
+        }
+    }
+    
+    if (length > 0 && tf_reader.line[length - 1] == '\r') {
+        length--;
+    }
+    
+    char* result = tf_string_alloc(length);
+    memcpy(result, tf_reader.line, length);
+    return result;
+}
+
+int64_t tf_budget_counter = 0;
+
+static struct {
+    int64_t max_steps;
+    int64_t max_ms;
+    int64_t max_mem;
+    int64_t used_steps;
+    int64_t start_ms;
+} tf_budget;
+
+static int64_t tf_monotonic_ms(void) {
+    struct {
+        long tv_sec;
+        long tv_nsec;
+    } now;
+    
+    tf_syscall3(TF_SYS_CLOCK_GETTIME, TF_CLOCK_MONOTONIC, (long)&now, 0);
+    return (int64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+static __attribute__((noreturn)) void tf_budget_exceeded(const char* prefix, int64_t limit, const char* suffix) {
+    char buffer[24];
+    char* end = buffer + sizeof(buffer) - 1;
+    *end = '\0';
+    tf_fail(prefix, tf_format_u64((uint64_t)limit, end), suffix);
+}
+
+void tf_budget_init(int64_t max_steps, int64_t max_ms, int64_t max_mem) {
+    tf_budget.max_steps = max_steps;
+    tf_budget.max_ms = max_ms;
+    tf_budget.max_mem = max_mem;
+    tf_budget.used_steps = 0;
+    tf_budget.start_ms = tf_monotonic_ms();
+    tf_used_memory = 0;
+    tf_budget_counter = 0;
+}
+
+void tf_budget_tick(void) {
+    int64_t slice = TF_BUDGET_SLICE;
+    
+    if (tf_budget.max_steps > 0) {
+        int64_t used = tf_budget.used_steps;
+        tf_budget.used_steps += slice;
+        if (used >= tf_budget.max_steps) {
+            tf_budget_exceeded("Erro: limite de ", tf_budget.max_steps, " passos excedido");
+        }
+        if (tf_budget.max_steps - used < slice) {
+            slice = tf_budget.max_steps - used;
+        }
+    }
+    
+    if (tf_budget.max_ms > 0 && tf_monotonic_ms() - tf_budget.start_ms > tf_budget.max_ms) {
+        tf_budget_exceeded("Erro: limite de tempo de ", tf_budget.max_ms, " ms excedido");
+    }
+    
+    if (tf_budget.max_mem > 0 && tf_used_memory > tf_budget.max_mem) {
+        tf_budget_exceeded("Erro: limite de memória de ", tf_budget.max_mem, " bytes excedido");
+    }
+    
+    tf_budget_counter = slice - 1;
+}
+
+int main(void);
+
+static const char* tf_find_env(char** envp, const char* name) {
+    size_t length = tf_cstring_length(name);
+    
+    for (; *envp != NULL; envp++) {
+        if (memcmp(*envp, name, length) == 0 && (*envp)[length] == '=') {
+            return *envp + length + 1;
+        }
+    }
+    return NULL;
+}
+
+__attribute__((used, noreturn)) void tf_minimal_start(long* stack) {
+    long argc = stack[0];
+    char** envp = (char**)(stack + 1 + argc + 1);
+    
+    tf_output_env = tf_find_env(envp, "TECHFLOW_OUTPUT");
+    
+    int status = main();
+    tf_output_flush();
+    tf_exit(status);
+}
+
+#if defined(__x86_64__)
+__asm__(".text\n"
+        ".global _start\n"
+        ".type _start, @function\n"
+        "_start:\n"
+        "    xor %rbp, %rbp\n"
+        "    mov %rsp, %rdi\n"
+        "    and $-16, %rsp\n"
+        "    call tf_minimal_start\n"
+        "    hlt\n");
+#else
+__asm__(".text\n"
+        ".global _start\n"
+        ".type _start, %function\n"
+        "_start:\n"
+        "    mov x29, #0\n"
+        "    mov x30, #0\n"
+        "    mov x0, sp\n"
+        "    and sp, x0, #-16\n"
+        "    bl tf_minimal_start\n"
+        "    brk #0\n");
+#endif
@@ -1,33 +1,1785 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/uio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <ucontext.h>
+#include "runtime_support.h"
 
-const char* bool_to_string(int boolean_value) {
-    return boolean_value ? "true" : "false";
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#ifdef TF_MEM_STATS
+#include "mem_stats.h"
+
+static void tf_report_mem_stats(void) {
+    tf_mem_stats_report(stderr);
 }
 
-char* concat_strings(const char* str1, const char* str2) {
-    size_t len1 = strlen(str1);
-    size_t len2 = strlen(str2);
-    char* result = (char*)malloc(len1 + len2 + 1);
+__attribute__((constructor)) static void tf_enable_mem_stats(void) {
+    tf_mem_stats_enable();
+    atexit(tf_report_mem_stats);
+}
+#else
+#define tf_malloc malloc
+#define tf_calloc calloc
+#define tf_realloc realloc
+#define tf_free free
+#endif
+
+#define TF_BUDGET_SLICE 1024
+
+__thread int64_t tf_budget_counter = 0;
+
+static struct {
+    int64_t max_steps;
+    int64_t max_ms;
+    int64_t max_mem;
+    int64_t used_steps;
+    double start_ms;
+    int64_t used_mem;
+} tf_budget;
+
+double tf_monotonic_ms(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000.0 + now.tv_nsec / 1000000.0;
+}
+
+static void tf_budget_exceeded(const char* message, int64_t limit) {
+    tf_output_flush();
+    fprintf(stderr, message, (long long)limit);
+    fputc('\n', stderr);
+    exit(1);
+}
+
+void tf_budget_init(int64_t max_steps, int64_t max_ms, int64_t max_mem) {
+    tf_budget.max_steps = max_steps;
+    tf_budget.max_ms = max_ms;
+    tf_budget.max_mem = max_mem;
+    tf_budget.used_steps = 0;
+    tf_budget.start_ms = tf_monotonic_ms();
+    tf_budget.used_mem = 0;
+    tf_budget_counter = 0;
+}
+
+void tf_budget_tick(void) {
+    int64_t slice = TF_BUDGET_SLICE;
+    
+    if (tf_budget.max_steps > 0) {
+        int64_t used = __atomic_fetch_add(&tf_budget.used_steps, slice, __ATOMIC_RELAXED);
+        if (used >= tf_budget.max_steps) {
+            tf_budget_exceeded("Erro: limite de %lld passos excedido", tf_budget.max_steps);
+        }
+        if (tf_budget.max_steps - used < slice) {
+            slice = tf_budget.max_steps - used;
+        }
+    }
+    
+    if (tf_budget.max_ms > 0 && tf_monotonic_ms() - tf_budget.start_ms > tf_budget.max_ms) {
+        tf_budget_exceeded("Erro: limite de tempo de %lld ms excedido", tf_budget.max_ms);
+    }
+    
+    if (tf_budget.max_mem > 0 && __atomic_load_n(&tf_budget.used_mem, __ATOMIC_RELAXED) > tf_budget.max_mem) {
+        tf_budget_exceeded("Erro: limite de memória de %lld bytes excedido", tf_budget.max_mem);
+    }
+    
+    tf_budget_counter = slice - 1;
+}
+
+typedef struct {
+    int64_t calls;
+    int64_t bytes;
+} TFInstrumentCounter;
+
+static struct {
+    int enabled;
+    const char* program;
+    const TFInstrumentLoop* loops;
+    int loop_count;
+    pthread_mutex_t dump_lock;
+    TFInstrumentCounter log;
+    TFInstrumentCounter concat_strings;
+    TFInstrumentCounter int_to_string;
+    TFInstrumentCounter read_str;
+} tf_instrument = {
+    .dump_lock = PTHREAD_MUTEX_INITIALIZER
+};
+
+static inline void tf_instrument_count(TFInstrumentCounter* counter, size_t bytes) {
+    __atomic_fetch_add(&counter->calls, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&counter->bytes, (int64_t)bytes, __ATOMIC_RELAXED);
+}
+
+static void tf_instrument_write_string(FILE* file, const char* text) {
+    fputc('"', file);
+    for (const unsigned char* c = (const unsigned char*)text; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(file, "\\%c", *c);
+        } else if (*c < 0x20) {
+            fprintf(file, "\\u%04x", *c);
+        } else {
+            fputc(*c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+static void tf_instrument_write_counter(FILE* file, const char* name, const TFInstrumentCounter* counter,
+                                        const char* separator) {
+    fprintf(file, "    \"%s\": { \"calls\": %lld, \"bytes\": %lld }%s\n", name,
+            (long long)__atomic_load_n(&counter->calls, __ATOMIC_RELAXED),
+            (long long)__atomic_load_n(&counter->bytes, __ATOMIC_RELAXED), separator);
+}
+
+void tf_instrument_dump(FILE* file) {
+    fprintf(file, "{\n  \"program\": ");
+    tf_instrument_write_string(file, tf_instrument.program != NULL ? tf_instrument.program : "");
+    fprintf(file, ",\n  \"loops\": [\n");
+    
+    for (int i = 0; i < tf_instrument.loop_count; i++) {
+        const TFInstrumentLoop* loop = &tf_instrument.loops[i];
+        fprintf(file, "    { \"kind\": \"%s\", \"line\": %d, \"iterations\": %lld }%s\n", loop->kind, loop->line,
+                (long long)__atomic_load_n(loop->counter, __ATOMIC_RELAXED),
+                i + 1 < tf_instrument.loop_count ? "," : "");
+    }
+    
+    fprintf(file, "  ],\n  \"log\": { \"calls\": %lld, \"bytes\": %lld },\n  \"allocations\": {\n",
+            (long long)__atomic_load_n(&tf_instrument.log.calls, __ATOMIC_RELAXED),
+            (long long)__atomic_load_n(&tf_instrument.log.bytes, __ATOMIC_RELAXED));
+    tf_instrument_write_counter(file, "concat_strings", &tf_instrument.concat_strings, ",");
+    tf_instrument_write_counter(file, "int_to_string", &tf_instrument.int_to_string, ",");
+    tf_instrument_write_counter(file, "reader", &tf_instrument.read_str, "");
+    fprintf(file, "  }\n}\n");
+}
+
+static void tf_instrument_write(void) {
+    const char* path = getenv("TECHFLOW_INSTRUMENT_OUTPUT");
+    
+    pthread_mutex_lock(&tf_instrument.dump_lock);
+    if (path != NULL && path[0] != '\0') {
+        FILE* file = fopen(path, "w");
+        if (file != NULL) {
+            tf_instrument_dump(file);
+            fclose(file);
+        } else {
+            fprintf(stderr, "Erro: não foi possível gravar os contadores em '%s'\n", path);
+        }
+    } else {
+        tf_instrument_dump(stderr);
+    }
+    pthread_mutex_unlock(&tf_instrument.dump_lock);
+}
+
+static void* tf_instrument_signal_main(void* arg) {
+    sigset_t* signals = (sigset_t*)arg;
+    int signal_number;
+    
+    while (sigwait(signals, &signal_number) == 0) {
+        tf_instrument_write();
+    }
+    return NULL;
+}
+
+void tf_instrument_register(const char* program, const TFInstrumentLoop* loops, int loop_count) {
+    static sigset_t signals;
+    
+    tf_instrument.program = program;
+    tf_instrument.loops = loops;
+    tf_instrument.loop_count = loop_count;
+    tf_instrument.enabled = 1;
+    
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGUSR1);
+    pthread_sigmask(SIG_BLOCK, &signals, NULL);
+    
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, tf_instrument_signal_main, &signals) == 0) {
+        pthread_detach(thread);
+    }
     
+    atexit(tf_instrument_write);
+}
+
+typedef struct {
+    size_t length;
+    char data[];
+} TFString;
+
+#define TF_STRING_HEADER(str) ((const TFString*)((str) - offsetof(TFString, data)))
+
+static const struct {
+    size_t length;
+    char data[6];
+} tf_true_string = { 4, "true" }, tf_false_string = { 5, "false" };
+
+size_t tf_string_length(const char* str) {
+    return TF_STRING_HEADER(str)->length;
+}
+
+char* tf_string_alloc(size_t length) {
+    TFString* result = (TFString*)tf_malloc(sizeof(TFString) + length + 1);
+
     if (!result) {
         fprintf(stderr, "Erro: Falha na alocação de memória\n");
         exit(1);
     }
+
+    if (tf_budget.max_mem > 0) {
+        __atomic_fetch_add(&tf_budget.used_mem, (int64_t)(sizeof(TFString) + length + 1), __ATOMIC_RELAXED);
+    }
     
-    strcpy(result, str1);
-    strcat(result, str2);
+    result->length = length;
+    result->data[length] = '\0';
+    return result->data;
+}
+
+static size_t tf_first_difference(const unsigned char* a, const unsigned char* b, size_t length) {
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    for (; i + 16 <= length; i += 16) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb));
+
+        if (mask != 0xFFFF) {
+            return i + (size_t)__builtin_ctz(~mask & 0xFFFF);
+        }
+    }
+#endif
+
+    for (; i < length; i++) {
+        if (a[i] != b[i]) {
+            return i;
+        }
+    }
+
+    return length;
+}
+
+int tf_string_equals(const char* str1, const char* str2) {
+    size_t len1 = tf_string_length(str1);
+
+    if (str1 == str2) return 1;
+    if (len1 != tf_string_length(str2)) return 0;
+
+    return tf_first_difference((const unsigned char*)str1, (const unsigned char*)str2, len1) == len1;
+}
+
+int tf_string_compare(const char* str1, const char* str2) {
+    size_t len1 = tf_string_length(str1);
+    size_t len2 = tf_string_length(str2);
+    size_t common = len1 < len2 ? len1 : len2;
+
+    size_t diff = tf_first_difference((const unsigned char*)str1, (const unsigned char*)str2, common);
+
+    if (diff < common) {
+        return (unsigned char)str1[diff] < (unsigned char)str2[diff] ? -1 : 1;
+    }
+
+    return len1 < len2 ? -1 : (len1 > len2 ? 1 : 0);
+}
+
+const char* bool_to_string(int boolean_value) {
+    return boolean_value ? tf_true_string.data : tf_false_string.data;
+}
+
+char* concat_strings(const char* str1, const char* str2) {
+    size_t len1 = tf_string_length(str1);
+    size_t len2 = tf_string_length(str2);
+    char* result = tf_string_alloc(len1 + len2);
+
+    if (tf_instrument.enabled) {
+        tf_instrument_count(&tf_instrument.concat_strings, len1 + len2 + 1);
+    }
     
+    memcpy(result, str1, len1);
+    memcpy(result + len1, str2, len2);
+
     return result;
 }
 
 char* int_to_string(int int_value) {
-    char* buffer = (char*)malloc(20);
-    if (!buffer) {
+    char buffer[16];
+    int length = snprintf(buffer, sizeof(buffer), "%d", int_value);
+    char* result = tf_string_alloc((size_t)length);
+
+    if (tf_instrument.enabled) {
+        tf_instrument_count(&tf_instrument.int_to_string, (size_t)length + 1);
+    }
+    
+    memcpy(result, buffer, (size_t)length);
+    return result;
+}
+
+#define TF_OUTPUT_BUFFER_SIZE (1 << 20)
+#define TF_OUTPUT_INTERVAL_MS 20
+
+typedef enum {
+    TF_OUTPUT_AUTO,
+    TF_OUTPUT_LINE,
+    TF_OUTPUT_BATCH,
+    TF_OUTPUT_ASYNC
+} TFOutputPolicy;
+
+typedef struct {
+    pthread_once_t once;
+    pthread_mutex_t lock;
+    pthread_cond_t drain_cond;
+    pthread_cond_t space_cond;
+    TFOutputPolicy policy;
+    char* buffers[2];
+    int active;
+    size_t used;
+    int writing;
+    int flush_requested;
+} TFOutput;
+
+static TFOutput tf_output = {
+    .once = PTHREAD_ONCE_INIT,
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .drain_cond = PTHREAD_COND_INITIALIZER,
+    .space_cond = PTHREAD_COND_INITIALIZER,
+    .policy = TF_OUTPUT_AUTO
+};
+
+static void tf_output_write_fd(const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = write(STDOUT_FILENO, data, length);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+}
+
+static void tf_output_drain_locked(void) {
+    tf_output_write_fd(tf_output.buffers[tf_output.active], tf_output.used);
+    tf_output.used = 0;
+}
+
+static void* tf_output_writer_main(void* arg) {
+    (void)arg;
+    pthread_mutex_lock(&tf_output.lock);
+    
+    while (1) {
+        while (tf_output.used == 0) {
+            tf_output.flush_requested = 0;
+            pthread_cond_broadcast(&tf_output.space_cond);
+            pthread_cond_wait(&tf_output.drain_cond, &tf_output.lock);
+        }
+        
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += TF_OUTPUT_INTERVAL_MS * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        
+        while (!tf_output.flush_requested && tf_output.used < TF_OUTPUT_BUFFER_SIZE / 2) {
+            if (pthread_cond_timedwait(&tf_output.drain_cond, &tf_output.lock, &deadline) == ETIMEDOUT) {
+                break;
+            }
+        }
+        
+        char* data = tf_output.buffers[tf_output.active];
+        size_t length = tf_output.used;
+        tf_output.active ^= 1;
+        tf_output.used = 0;
+        tf_output.writing = 1;
+        pthread_cond_broadcast(&tf_output.space_cond);
+        
+        pthread_mutex_unlock(&tf_output.lock);
+        tf_output_write_fd(data, length);
+        pthread_mutex_lock(&tf_output.lock);
+        
+        tf_output.writing = 0;
+    }
+    
+    return NULL;
+}
+
+static void tf_output_exit(void) {
+    tf_output_flush();
+}
+
+static void tf_output_init(void) {
+    if (tf_output.policy == TF_OUTPUT_AUTO) {
+        const char* env = getenv("TECHFLOW_OUTPUT");
+        
+        if (env != NULL && strcmp(env, "line") == 0) {
+            tf_output.policy = TF_OUTPUT_LINE;
+        } else if (env != NULL && strcmp(env, "batch") == 0) {
+            tf_output.policy = TF_OUTPUT_BATCH;
+        } else if (env != NULL && strcmp(env, "async") == 0) {
+            tf_output.policy = TF_OUTPUT_ASYNC;
+        } else if (isatty(STDOUT_FILENO)) {
+            tf_output.policy = TF_OUTPUT_LINE;
+        } else {
+            tf_output.policy = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? TF_OUTPUT_ASYNC : TF_OUTPUT_BATCH;
+        }
+    }
+    
+    if (tf_output.policy == TF_OUTPUT_LINE) return;
+    
+    int buffer_count = tf_output.policy == TF_OUTPUT_ASYNC ? 2 : 1;
+    for (int i = 0; i < buffer_count; i++) {
+        tf_output.buffers[i] = (char*)tf_malloc(TF_OUTPUT_BUFFER_SIZE);
+        if (!tf_output.buffers[i]) {
+            fprintf(stderr, "Erro: Falha na alocação de memória\n");
+            exit(1);
+        }
+    }
+    
+    if (tf_output.policy == TF_OUTPUT_ASYNC) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, tf_output_writer_main, NULL) != 0) {
+            tf_output.policy = TF_OUTPUT_BATCH;
+        } else {
+            pthread_detach(thread);
+        }
+    }
+    
+    atexit(tf_output_exit);
+}
+
+void tf_output_line(const char* data, size_t length) {
+    pthread_once(&tf_output.once, tf_output_init);
+    
+    if (tf_instrument.enabled) {
+        tf_instrument_count(&tf_instrument.log, length + 1);
+    }
+    
+    if (tf_output.policy == TF_OUTPUT_LINE) {
+        pthread_mutex_lock(&tf_output.lock);
+        struct iovec parts[] = {
+            { (void*)data, length },
+            { (void*)"\n", 1 }
+        };
+        ssize_t written = writev(STDOUT_FILENO, parts, 2);
+        if (written < 0) {
+            written = 0;
+        }
+        if ((size_t)written < length) {
+            tf_output_write_fd(data + written, length - (size_t)written);
+            tf_output_write_fd("\n", 1);
+        } else if ((size_t)written == length) {
+            tf_output_write_fd("\n", 1);
+        }
+        pthread_mutex_unlock(&tf_output.lock);
+        return;
+    }
+    
+    pthread_mutex_lock(&tf_output.lock);
+    
+    if (tf_output.policy == TF_OUTPUT_BATCH) {
+        if (tf_output.used + length + 1 > TF_OUTPUT_BUFFER_SIZE) {
+            tf_output_drain_locked();
+        }
+        if (length + 1 > TF_OUTPUT_BUFFER_SIZE) {
+            tf_output_write_fd(data, length);
+            tf_output_write_fd("\n", 1);
+            pthread_mutex_unlock(&tf_output.lock);
+            return;
+        }
+    } else {
+        if (length + 1 > TF_OUTPUT_BUFFER_SIZE) {
+            while (tf_output.used > 0 || tf_output.writing) {
+                tf_output.flush_requested = 1;
+                pthread_cond_signal(&tf_output.drain_cond);
+                pthread_cond_wait(&tf_output.space_cond, &tf_output.lock);
+            }
+            tf_output_write_fd(data, length);
+            tf_output_write_fd("\n", 1);
+            pthread_mutex_unlock(&tf_output.lock);
+            return;
+        }
+        while (tf_output.used + length + 1 > TF_OUTPUT_BUFFER_SIZE) {
+            tf_output.flush_requested = 1;
+            pthread_cond_signal(&tf_output.drain_cond);
+            pthread_cond_wait(&tf_output.space_cond, &tf_output.lock);
+        }
+    }
+    
+    size_t previous = tf_output.used;
+    char* buffer = tf_output.buffers[tf_output.active];
+    memcpy(buffer + previous, data, length);
+    buffer[previous + length] = '\n';
+    tf_output.used = previous + length + 1;
+    
+    if (tf_output.policy == TF_OUTPUT_ASYNC &&
+        (previous == 0 || (previous < TF_OUTPUT_BUFFER_SIZE / 2 && tf_output.used >= TF_OUTPUT_BUFFER_SIZE / 2))) {
+        pthread_cond_signal(&tf_output.drain_cond);
+    }
+    
+    pthread_mutex_unlock(&tf_output.lock);
+}
+
+void tf_output_block(const char* data, size_t length) {
+    pthread_once(&tf_output.once, tf_output_init);
+    tf_output_flush();
+    
+    pthread_mutex_lock(&tf_output.lock);
+    tf_output_write_fd(data, length);
+    pthread_mutex_unlock(&tf_output.lock);
+}
+
+void tf_output_flush(void) {
+    if (tf_output.policy == TF_OUTPUT_AUTO || tf_output.policy == TF_OUTPUT_LINE) return;
+    
+    pthread_mutex_lock(&tf_output.lock);
+    
+    if (tf_output.policy == TF_OUTPUT_BATCH) {
+        tf_output_drain_locked();
+    } else {
+        while (tf_output.used > 0 || tf_output.writing) {
+            tf_output.flush_requested = 1;
+            pthread_cond_signal(&tf_output.drain_cond);
+            pthread_cond_wait(&tf_output.space_cond, &tf_output.lock);
+        }
+    }
+    
+    pthread_mutex_unlock(&tf_output.lock);
+}
+
+void tf_log_i32(int value) {
+    char buffer[16];
+    char* end = buffer + sizeof(buffer);
+    char* start = end;
+    unsigned int magnitude = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+    
+    do {
+        *--start = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    
+    if (value < 0) {
+        *--start = '-';
+    }
+    
+    tf_output_line(start, (size_t)(end - start));
+}
+
+void tf_log_str(const char* str) {
+    tf_output_line(str, tf_string_length(str));
+}
+
+#define TF_READER_BUFFER_SIZE (1 << 16)
+
+struct TFReader {
+    pthread_mutex_t lock;
+    FILE* file;
+    const char* data;
+    size_t length;
+    size_t position;
+    size_t base;
+    int initialized;
+    int mapped;
+    int interactive;
+    size_t mapped_length;
+    char* line;
+    size_t line_capacity;
+    char buffer[TF_READER_BUFFER_SIZE];
+};
+
+TFReader* tf_reader_open(FILE* file) {
+    TFReader* reader = (TFReader*)tf_calloc(1, sizeof(TFReader));
+
+    if (!reader) {
+        fprintf(stderr, "Erro: Falha na alocação de memória\n");
+        exit(1);
+    }
+
+    pthread_mutex_init(&reader->lock, NULL);
+    reader->file = file;
+    return reader;
+}
+
+void tf_reader_close(TFReader* reader) {
+    if (reader == NULL) return;
+
+    if (reader->mapped) {
+        munmap((void*)reader->data, reader->mapped_length);
+    }
+
+    pthread_mutex_destroy(&reader->lock);
+    tf_free(reader->line);
+    tf_free(reader);
+}
+
+void tf_reader_lock(TFReader* reader) {
+    pthread_mutex_lock(&reader->lock);
+}
+
+void tf_reader_unlock(TFReader* reader) {
+    pthread_mutex_unlock(&reader->lock);
+}
+
+static void tf_reader_init(TFReader* reader) {
+    struct stat st;
+    int fd = reader->file ? fileno(reader->file) : -1;
+
+    reader->initialized = 1;
+    reader->data = reader->buffer;
+
+    if (fd >= 0 && fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        long offset = ftell(reader->file);
+        void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (map != MAP_FAILED) {
+            reader->data = (const char*)map;
+            reader->length = (size_t)st.st_size;
+            reader->position = offset > 0 ? (size_t)offset : 0;
+            reader->mapped = 1;
+            reader->mapped_length = (size_t)st.st_size;
+        }
+    }
+    
+    reader->interactive = !reader->mapped && fd >= 0 && isatty(fd);
+}
+
+static int tf_reader_fill(TFReader* reader) {
+    if (!reader->initialized) {
+        tf_reader_init(reader);
+        if (reader->position < reader->length) return 1;
+    }
+
+    if (reader->mapped || reader->file == NULL) return 0;
+
+    ssize_t count;
+    if (reader->interactive) {
+        do {
+            count = read(fileno(reader->file), reader->buffer, TF_READER_BUFFER_SIZE);
+        } while (count < 0 && errno == EINTR);
+    } else {
+        count = (ssize_t)fread(reader->buffer, 1, TF_READER_BUFFER_SIZE, reader->file);
+    }
+    if (count <= 0) return 0;
+
+    reader->base += reader->length;
+    reader->length = (size_t)count;
+    reader->position = 0;
+    return 1;
+}
+
+static inline int tf_reader_peek(TFReader* reader) {
+    if (reader->position >= reader->length && !tf_reader_fill(reader)) {
+        return EOF;
+    }
+    return (unsigned char)reader->data[reader->position];
+}
+
+size_t tf_reader_read_line(TFReader* reader, const char** line) {
+    size_t length = 0;
+    int c;
+
+    while ((c = tf_reader_peek(reader)) != EOF) {
+        const char* start = reader->data + reader->position;
+        size_t available = reader->length - reader->position;
+        const char* newline = (const char*)memchr(start, '\n', available);
+        size_t chunk = newline ? (size_t)(newline - start) : available;
+
+        if (length + chunk + 1 > reader->line_capacity) {
+            size_t capacity = reader->line_capacity == 0 ? 256 : reader->line_capacity;
+            while (capacity < length + chunk + 1) capacity *= 2;
+
+            char* new_line = (char*)tf_realloc(reader->line, capacity);
+            if (!new_line) {
+                fprintf(stderr, "Erro: Falha na alocação de memória\n");
+                exit(1);
+            }
+
+            reader->line = new_line;
+            reader->line_capacity = capacity;
+        }
+
+        memcpy(reader->line + length, start, chunk);
+        length += chunk;
+        reader->position += chunk;
+
+        if (newline) {
+            reader->position++;
+            break;
+        }
+    }
+
+    if (length > 0 && reader->line[length - 1] == '\r') {
+        length--;
+    }
+
+    if (reader->line) {
+        reader->line[length] = '\0';
+    }
+
+    *line = reader->line ? reader->line : "";
+    return length;
+}
+
+size_t tf_reader_offset(const TFReader* reader) {
+    return reader->base + reader->position;
+}
+
+int tf_reader_skip(TFReader* reader, size_t offset) {
+    if (!reader->initialized) {
+        tf_reader_init(reader);
+    }
+    
+    while (reader->base + reader->length < offset) {
+        reader->position = reader->length;
+        if (!tf_reader_fill(reader)) return 0;
+    }
+    
+    if (offset < reader->base) return 0;
+    reader->position = offset - reader->base;
+    return 1;
+}
+
+TFReadStatus tf_reader_read_i32(TFReader* reader, int* value) {
+    int c = tf_reader_peek(reader);
+
+    while (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+        reader->position++;
+        c = tf_reader_peek(reader);
+    }
+
+    if (c == EOF) {
+        *value = 0;
+        return TF_READ_OK;
+    }
+
+    int negative = 0;
+    if (c == '-' || c == '+') {
+        negative = c == '-';
+        reader->position++;
+        c = tf_reader_peek(reader);
+    }
+
+    if (c < '0' || c > '9') {
+        return TF_READ_INVALID;
+    }
+
+    long long result = 0;
+    while (c >= '0' && c <= '9') {
+        result = result * 10 + (c - '0');
+        if (result > 2147483648LL) {
+            return TF_READ_OUT_OF_RANGE;
+        }
+        reader->position++;
+        c = tf_reader_peek(reader);
+    }
+
+    if (negative) result = -result;
+    if (result > 2147483647LL) {
+        return TF_READ_OUT_OF_RANGE;
+    }
+
+    while (c == ' ' || c == '\t' || c == '\r') {
+        reader->position++;
+        c = tf_reader_peek(reader);
+    }
+    if (c == '\n') {
+        reader->position++;
+    }
+
+    *value = (int)result;
+    return TF_READ_OK;
+}
+
+static TFReader* tf_stdin = NULL;
+static pthread_once_t tf_stdin_once = PTHREAD_ONCE_INIT;
+
+static void tf_stdin_open(void) {
+    tf_stdin = tf_reader_open(stdin);
+}
+
+static TFReader* tf_stdin_reader(void) {
+    pthread_once(&tf_stdin_once, tf_stdin_open);
+    return tf_stdin;
+}
+
+int tf_read_i32(void) {
+    TFReader* reader = tf_stdin_reader();
+    int value;
+
+    tf_reader_lock(reader);
+    TFReadStatus status = tf_reader_read_i32(reader, &value);
+    tf_reader_unlock(reader);
+
+    switch (status) {
+        case TF_READ_INVALID:
+            tf_output_flush();
+            fprintf(stderr, "Erro: Valor inválido para reader\n");
+            exit(1);
+        case TF_READ_OUT_OF_RANGE:
+            tf_output_flush();
+            fprintf(stderr, "Erro: Valor fora do intervalo de i32 em reader\n");
+            exit(1);
+        default:
+            return value;
+    }
+}
+
+char* tf_read_str(void) {
+    TFReader* reader = tf_stdin_reader();
+    const char* line;
+
+    tf_reader_lock(reader);
+    size_t length = tf_reader_read_line(reader, &line);
+    char* result = tf_string_alloc(length);
+    memcpy(result, line, length);
+    tf_reader_unlock(reader);
+
+    if (tf_instrument.enabled) {
+        tf_instrument_count(&tf_instrument.read_str, length + 1);
+    }
+    
+    return result;
+}
+
+int tf_stdin_read_line(const char** line, size_t* length) {
+    TFReader* reader = tf_stdin_reader();
+    
+    if (tf_reader_peek(reader) == EOF) return 0;
+    
+    *length = tf_reader_read_line(reader, line);
+    return 1;
+}
+
+#define TF_PARALLEL_MAX_WORKERS 256
+#define TF_PARALLEL_CHUNKS_PER_WORKER 64
+#define TF_CACHE_LINE 64
+
+typedef struct {
+    pthread_mutex_t lock;
+    int next;
+    int end;
+} __attribute__((aligned(TF_CACHE_LINE))) TFWorkerRange;
+
+typedef struct {
+    TFParallelBody body;
+    void* env;
+    int grain;
+    int* partials;
+    int stride;
+} TFParallelJob;
+
+typedef struct {
+    pthread_once_t once;
+    pthread_mutex_t job_lock;
+    pthread_mutex_t lock;
+    pthread_cond_t work_cond;
+    pthread_cond_t done_cond;
+    int worker_count;
+    unsigned long generation;
+    int active;
+    int running;
+    TFParallelJob job;
+    TFWorkerRange ranges[TF_PARALLEL_MAX_WORKERS];
+} TFThreadPool;
+
+static TFThreadPool tf_pool = {
+    .once = PTHREAD_ONCE_INIT,
+    .job_lock = PTHREAD_MUTEX_INITIALIZER,
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .work_cond = PTHREAD_COND_INITIALIZER,
+    .done_cond = PTHREAD_COND_INITIALIZER
+};
+
+static __thread int tf_in_parallel = 0;
+
+int tf_parallel_identity(int op) {
+    return (op == TF_REDUCE_MUL || op == TF_REDUCE_AND) ? 1 : 0;
+}
+
+int tf_parallel_combine(int op, int left, int right) {
+    switch (op) {
+        case TF_REDUCE_ADD:
+            return (int)((unsigned int)left + (unsigned int)right);
+        case TF_REDUCE_MUL:
+            return (int)((unsigned int)left * (unsigned int)right);
+        case TF_REDUCE_AND:
+            return left && right;
+        case TF_REDUCE_OR:
+            return left || right;
+        default:
+            fprintf(stderr, "Erro: Operador de redução desconhecido: %d\n", op);
+            exit(1);
+    }
+}
+
+static int tf_parallel_take_local(int id, int* start, int* end) {
+    TFWorkerRange* range = &tf_pool.ranges[id];
+    int found = 0;
+
+    pthread_mutex_lock(&range->lock);
+    if (range->next < range->end) {
+        *start = range->next;
+        *end = range->end - range->next > tf_pool.job.grain ? range->next + tf_pool.job.grain : range->end;
+        range->next = *end;
+        found = 1;
+    }
+    pthread_mutex_unlock(&range->lock);
+
+    return found;
+}
+
+static int tf_parallel_steal(int id) {
+    for (int offset = 1; offset < tf_pool.worker_count; offset++) {
+        TFWorkerRange* victim = &tf_pool.ranges[(id + offset) % tf_pool.worker_count];
+        int stolen_start = 0, stolen_end = 0;
+
+        pthread_mutex_lock(&victim->lock);
+        int remaining = victim->end - victim->next;
+        if (remaining > 0) {
+            stolen_start = victim->next + remaining / 2;
+            stolen_end = victim->end;
+            victim->end = stolen_start;
+        }
+        pthread_mutex_unlock(&victim->lock);
+
+        if (stolen_end > stolen_start) {
+            TFWorkerRange* own = &tf_pool.ranges[id];
+            pthread_mutex_lock(&own->lock);
+            own->next = stolen_start;
+            own->end = stolen_end;
+            pthread_mutex_unlock(&own->lock);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static void tf_parallel_run_worker(int id) {
+    int* partials = tf_pool.job.partials + (size_t)id * tf_pool.job.stride;
+    int start, end;
+
+    tf_in_parallel = 1;
+    __atomic_add_fetch(&tf_pool.running, 1, __ATOMIC_SEQ_CST);
+    for (;;) {
+        if (tf_parallel_take_local(id, &start, &end)) {
+            tf_pool.job.body(tf_pool.job.env, start, end, partials);
+        } else if (!tf_parallel_steal(id)) {
+            break;
+        }
+    }
+    __atomic_sub_fetch(&tf_pool.running, 1, __ATOMIC_SEQ_CST);
+    tf_in_parallel = 0;
+}
+
+static void* tf_parallel_thread_main(void* arg) {
+    int id = (int)(size_t)arg;
+    unsigned long seen = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&tf_pool.lock);
+        while (tf_pool.generation == seen) {
+            pthread_cond_wait(&tf_pool.work_cond, &tf_pool.lock);
+        }
+        seen = tf_pool.generation;
+        pthread_mutex_unlock(&tf_pool.lock);
+
+        tf_parallel_run_worker(id);
+
+        pthread_mutex_lock(&tf_pool.lock);
+        if (--tf_pool.active == 0) {
+            pthread_cond_signal(&tf_pool.done_cond);
+        }
+        pthread_mutex_unlock(&tf_pool.lock);
+    }
+
+    return NULL;
+}
+
+static long tf_configured_threads(void) {
+    const char* env = getenv("TECHFLOW_THREADS");
+    long count = env ? strtol(env, NULL, 10) : sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (count < 1) count = 1;
+    if (count > TF_PARALLEL_MAX_WORKERS) count = TF_PARALLEL_MAX_WORKERS;
+    return count;
+}
+
+static void tf_parallel_init(void) {
+    long count = tf_configured_threads();
+
+    for (int i = 0; i < TF_PARALLEL_MAX_WORKERS; i++) {
+        pthread_mutex_init(&tf_pool.ranges[i].lock, NULL);
+    }
+
+    tf_pool.worker_count = 1;
+    for (long i = 1; i < count; i++) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, tf_parallel_thread_main, (void*)(size_t)i) != 0) {
+            break;
+        }
+        pthread_detach(thread);
+        tf_pool.worker_count++;
+    }
+}
+
+int tf_parallel_worker_count(void) {
+    pthread_once(&tf_pool.once, tf_parallel_init);
+    return tf_pool.worker_count;
+}
+
+void tf_parallel_for(int start, int end, TFParallelBody body, void* env,
+                     const int* reduce_ops, int* reduce_values, int reduce_count) {
+    if (end <= start) return;
+
+    int worker_count = tf_parallel_worker_count();
+    int stride = (reduce_count + 15) & ~15;
+    if (stride == 0) stride = 16;
+
+    if (tf_in_parallel || worker_count == 1) {
+        int local[stride];
+        for (int r = 0; r < reduce_count; r++) {
+            local[r] = tf_parallel_identity(reduce_ops[r]);
+        }
+        body(env, start, end, local);
+        for (int r = 0; r < reduce_count; r++) {
+            reduce_values[r] = tf_parallel_combine(reduce_ops[r], reduce_values[r], local[r]);
+        }
+        return;
+    }
+
+    int* partials = (int*)aligned_alloc(TF_CACHE_LINE, (size_t)worker_count * stride * sizeof(int));
+    if (!partials) {
         fprintf(stderr, "Erro: Falha na alocação de memória\n");
         exit(1);
     }
-    sprintf(buffer, "%d", int_value);
-    return buffer;
-}
\ No newline at end of file
+
+    for (int w = 0; w < worker_count; w++) {
+        for (int r = 0; r < reduce_count; r++) {
+            partials[w * stride + r] = tf_parallel_identity(reduce_ops[r]);
+        }
+    }
+
+    pthread_mutex_lock(&tf_pool.job_lock);
+
+    long total = (long)end - start;
+    long grain = total / ((long)worker_count * TF_PARALLEL_CHUNKS_PER_WORKER);
+    tf_pool.job.body = body;
+    tf_pool.job.env = env;
+    tf_pool.job.grain = grain < 1 ? 1 : (int)grain;
+    tf_pool.job.partials = partials;
+    tf_pool.job.stride = stride;
+
+    for (int w = 0; w < worker_count; w++) {
+        tf_pool.ranges[w].next = (int)(start + total * w / worker_count);
+        tf_pool.ranges[w].end = (int)(start + total * (w + 1) / worker_count);
+    }
+
+    pthread_mutex_lock(&tf_pool.lock);
+    tf_pool.active = worker_count - 1;
+    tf_pool.generation++;
+    pthread_cond_broadcast(&tf_pool.work_cond);
+    pthread_mutex_unlock(&tf_pool.lock);
+
+    tf_parallel_run_worker(0);
+
+    pthread_mutex_lock(&tf_pool.lock);
+    while (tf_pool.active > 0) {
+        pthread_cond_wait(&tf_pool.done_cond, &tf_pool.lock);
+    }
+    pthread_mutex_unlock(&tf_pool.lock);
+
+    pthread_mutex_unlock(&tf_pool.job_lock);
+
+    for (int w = 0; w < worker_count; w++) {
+        for (int r = 0; r < reduce_count; r++) {
+            reduce_values[r] = tf_parallel_combine(reduce_ops[r], reduce_values[r], partials[w * stride + r]);
+        }
+    }
+
+    free(partials);
+}
+
+#define TF_TASK_STACK_SIZE (1 << 20)
+#define TF_TASK_CACHE_SIZE 64
+#define TF_TASK_POLL_MS 20
+#define TF_CHANNEL_MAX_CAPACITY (1 << 24)
+
+typedef struct TFTask {
+    ucontext_t context;
+    ucontext_t* scheduler;
+    char* stack;
+    TFTaskGroup* group;
+    TFTaskBody body;
+    void* env;
+    pthread_mutex_t* release_lock;
+    void* local;
+    int finished;
+    struct TFTask* next;
+} TFTask;
+
+typedef struct TFWaiter {
+    TFTask* task;
+    pthread_cond_t cond;
+    int ready;
+    struct TFWaiter* next;
+} TFWaiter;
+
+typedef struct {
+    TFWaiter* head;
+    TFWaiter* tail;
+    int waiting;
+} TFWaitList;
+
+typedef struct {
+    uint64_t sequence;
+    uint64_t value;
+} TFChannelCell;
+
+struct TFChannel {
+    uint64_t send_position __attribute__((aligned(TF_CACHE_LINE)));
+    uint64_t receive_position __attribute__((aligned(TF_CACHE_LINE)));
+    TFChannelCell* cells __attribute__((aligned(TF_CACHE_LINE)));
+    uint64_t mask;
+    TFTaskGroup* group;
+    pthread_mutex_t lock;
+    TFWaitList senders;
+    TFWaitList receivers;
+    int closed;
+    struct TFChannel* next;
+};
+
+struct TFTaskGroup {
+    pthread_mutex_t lock;
+    pthread_cond_t done_cond;
+    int live;
+    int parked;
+    int blocked;
+    int cancelled;
+    TFChannel* channels;
+};
+
+static struct {
+    pthread_once_t once;
+    pthread_mutex_t lock;
+    pthread_cond_t work_cond;
+    TFTask* head;
+    TFTask* tail;
+    TFTask* cache;
+    int cached;
+    size_t page_size;
+} tf_scheduler = {
+    .once = PTHREAD_ONCE_INIT,
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .work_cond = PTHREAD_COND_INITIALIZER
+};
+
+static __thread TFTask* tf_current_task = NULL;
+static TFTaskLocalSwap tf_task_local_swap = NULL;
+
+void tf_task_set_local_swap(TFTaskLocalSwap swap) {
+    __atomic_store_n(&tf_task_local_swap, swap, __ATOMIC_RELEASE);
+}
+
+static void* tf_task_swap_local(void* value) {
+    TFTaskLocalSwap swap = __atomic_load_n(&tf_task_local_swap, __ATOMIC_ACQUIRE);
+    return swap != NULL ? swap(value) : NULL;
+}
+
+static void tf_task_fail(const char* message) {
+    tf_output_flush();
+    fprintf(stderr, "%s\n", message);
+    exit(1);
+}
+
+static void tf_scheduler_push(TFTask* task) {
+    task->next = NULL;
+    
+    pthread_mutex_lock(&tf_scheduler.lock);
+    if (tf_scheduler.tail != NULL) {
+        tf_scheduler.tail->next = task;
+    } else {
+        tf_scheduler.head = task;
+    }
+    tf_scheduler.tail = task;
+    pthread_cond_signal(&tf_scheduler.work_cond);
+    pthread_mutex_unlock(&tf_scheduler.lock);
+}
+
+static TFTask* tf_task_alloc(void) {
+    pthread_mutex_lock(&tf_scheduler.lock);
+    TFTask* task = tf_scheduler.cache;
+    if (task != NULL) {
+        tf_scheduler.cache = task->next;
+        tf_scheduler.cached--;
+    }
+    pthread_mutex_unlock(&tf_scheduler.lock);
+    
+    if (task != NULL) return task;
+    
+    task = (TFTask*)calloc(1, sizeof(TFTask));
+    if (task == NULL) {
+        tf_task_fail("Erro: Falha na alocação de memória");
+    }
+    
+    task->stack = (char*)mmap(NULL, TF_TASK_STACK_SIZE, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK, -1, 0);
+    if (task->stack == MAP_FAILED) {
+        tf_task_fail("Erro: não foi possível alocar a pilha da tarefa");
+    }
+    mprotect(task->stack, tf_scheduler.page_size, PROT_NONE);
+    return task;
+}
+
+static void tf_task_finish(TFTask* task) {
+    TFTaskGroup* group = task->group;
+    
+    pthread_mutex_lock(&tf_scheduler.lock);
+    if (tf_scheduler.cached < TF_TASK_CACHE_SIZE) {
+        task->next = tf_scheduler.cache;
+        tf_scheduler.cache = task;
+        tf_scheduler.cached++;
+        task = NULL;
+    }
+    pthread_mutex_unlock(&tf_scheduler.lock);
+    
+    if (task != NULL) {
+        munmap(task->stack, TF_TASK_STACK_SIZE);
+        free(task);
+    }
+    
+    pthread_mutex_lock(&group->lock);
+    if (--group->live == 0) {
+        pthread_cond_broadcast(&group->done_cond);
+    }
+    pthread_mutex_unlock(&group->lock);
+}
+
+static void tf_task_entry(void) {
+    TFTask* task = tf_current_task;
+    
+    task->body(task->env);
+    task->finished = 1;
+    setcontext(task->scheduler);
+}
+
+static void tf_task_park(TFTask* task, pthread_mutex_t* lock) {
+    task->release_lock = lock;
+    swapcontext(&task->context, task->scheduler);
+}
+
+static void* tf_scheduler_worker_main(void* arg) {
+    ucontext_t scheduler;
+    (void)arg;
+    
+    for (;;) {
+        pthread_mutex_lock(&tf_scheduler.lock);
+        while (tf_scheduler.head == NULL) {
+            pthread_cond_wait(&tf_scheduler.work_cond, &tf_scheduler.lock);
+        }
+        TFTask* task = tf_scheduler.head;
+        tf_scheduler.head = task->next;
+        if (tf_scheduler.head == NULL) {
+            tf_scheduler.tail = NULL;
+        }
+        pthread_mutex_unlock(&tf_scheduler.lock);
+        
+        task->scheduler = &scheduler;
+        tf_current_task = task;
+        void* scheduler_local = tf_task_swap_local(task->local);
+        swapcontext(&scheduler, &task->context);
+        task->local = tf_task_swap_local(scheduler_local);
+        tf_current_task = NULL;
+        
+        if (task->finished) {
+            tf_task_finish(task);
+        } else {
+            pthread_mutex_t* lock = task->release_lock;
+            task->release_lock = NULL;
+            pthread_mutex_unlock(lock);
+        }
+    }
+    
+    return NULL;
+}
+
+static void tf_scheduler_init(void) {
+    long count = tf_configured_threads();
+    tf_scheduler.page_size = (size_t)sysconf(_SC_PAGESIZE);
+    
+    for (long i = 0; i < count; i++) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, tf_scheduler_worker_main, NULL) != 0) {
+            if (i == 0) {
+                tf_task_fail("Erro: não foi possível iniciar o escalonador de tarefas");
+            }
+            break;
+        }
+        pthread_detach(thread);
+    }
+}
+
+TFTaskGroup* tf_task_group_create(void) {
+    TFTaskGroup* group = (TFTaskGroup*)calloc(1, sizeof(TFTaskGroup));
+    
+    if (group == NULL) {
+        tf_task_fail("Erro: Falha na alocação de memória");
+    }
+    
+    pthread_mutex_init(&group->lock, NULL);
+    pthread_cond_init(&group->done_cond, NULL);
+    return group;
+}
+
+void tf_task_spawn(TFTaskGroup* group, TFTaskBody body, void* env) {
+    pthread_once(&tf_scheduler.once, tf_scheduler_init);
+    
+    TFTask* task = tf_task_alloc();
+    task->group = group;
+    task->body = body;
+    task->env = env;
+    task->finished = 0;
+    task->release_lock = NULL;
+    task->local = NULL;
+    
+    getcontext(&task->context);
+    task->context.uc_stack.ss_sp = task->stack;
+    task->context.uc_stack.ss_size = TF_TASK_STACK_SIZE;
+    task->context.uc_link = NULL;
+    makecontext(&task->context, tf_task_entry, 0);
+    
+    pthread_mutex_lock(&group->lock);
+    group->live++;
+    pthread_mutex_unlock(&group->lock);
+    
+    tf_scheduler_push(task);
+}
+
+static int tf_parallel_waiting_threads(void) {
+    return tf_in_parallel ? __atomic_load_n(&tf_pool.running, __ATOMIC_SEQ_CST) : 1;
+}
+
+static int tf_task_group_stalled(TFTaskGroup* group, int waiting_threads) {
+    return __atomic_load_n(&group->live, __ATOMIC_SEQ_CST) == __atomic_load_n(&group->parked, __ATOMIC_SEQ_CST) &&
+           __atomic_load_n(&group->blocked, __ATOMIC_SEQ_CST) == waiting_threads;
+}
+
+static void tf_poll_deadline(struct timespec* deadline) {
+    clock_gettime(CLOCK_REALTIME, deadline);
+    deadline->tv_nsec += TF_TASK_POLL_MS * 1000000L;
+    if (deadline->tv_nsec >= 1000000000L) {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000L;
+    }
+}
+
+TFChannelStatus tf_task_group_wait(TFTaskGroup* group) {
+    TFChannelStatus status = TF_CHANNEL_OK;
+    
+    pthread_mutex_lock(&group->lock);
+    while (group->live > 0) {
+        struct timespec deadline;
+        tf_poll_deadline(&deadline);
+        
+        if (pthread_cond_timedwait(&group->done_cond, &group->lock, &deadline) == ETIMEDOUT &&
+            group->live > 0 && tf_task_group_stalled(group, 0)) {
+            status = TF_CHANNEL_DEADLOCK;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&group->lock);
+    
+    return status;
+}
+
+static void tf_wait_list_append(TFWaitList* list, TFWaiter* waiter) {
+    waiter->next = NULL;
+    if (list->tail != NULL) {
+        list->tail->next = waiter;
+    } else {
+        list->head = waiter;
+    }
+    list->tail = waiter;
+}
+
+static TFWaiter* tf_wait_list_pop(TFWaitList* list) {
+    TFWaiter* waiter = list->head;
+    
+    if (waiter != NULL) {
+        list->head = waiter->next;
+        if (list->head == NULL) {
+            list->tail = NULL;
+        }
+    }
+    return waiter;
+}
+
+static void tf_wait_list_remove(TFWaitList* list, TFWaiter* waiter) {
+    TFWaiter* previous = NULL;
+    
+    for (TFWaiter* current = list->head; current != NULL; previous = current, current = current->next) {
+        if (current == waiter) {
+            if (previous != NULL) {
+                previous->next = current->next;
+            } else {
+                list->head = current->next;
+            }
+            if (list->tail == current) {
+                list->tail = previous;
+            }
+            return;
+        }
+    }
+}
+
+static void tf_channel_wake(TFChannel* channel, TFWaiter* waiter) {
+    TFTask* task = waiter->task;
+    
+    waiter->ready = 1;
+    if (task != NULL) {
+        __atomic_sub_fetch(&channel->group->parked, 1, __ATOMIC_SEQ_CST);
+        tf_scheduler_push(task);
+    } else {
+        __atomic_sub_fetch(&channel->group->blocked, 1, __ATOMIC_SEQ_CST);
+        pthread_cond_signal(&waiter->cond);
+    }
+}
+
+static void tf_channel_wake_all(TFChannel* channel) {
+    TFWaiter* waiter;
+    
+    while ((waiter = tf_wait_list_pop(&channel->senders)) != NULL) {
+        tf_channel_wake(channel, waiter);
+    }
+    while ((waiter = tf_wait_list_pop(&channel->receivers)) != NULL) {
+        tf_channel_wake(channel, waiter);
+    }
+}
+
+void tf_task_group_cancel(TFTaskGroup* group) {
+    __atomic_store_n(&group->cancelled, 1, __ATOMIC_SEQ_CST);
+    
+    pthread_mutex_lock(&group->lock);
+    for (TFChannel* channel = group->channels; channel != NULL; channel = channel->next) {
+        pthread_mutex_lock(&channel->lock);
+        tf_channel_wake_all(channel);
+        pthread_mutex_unlock(&channel->lock);
+    }
+    pthread_mutex_unlock(&group->lock);
+}
+
+TFChannel* tf_channel_create(TFTaskGroup* group, int capacity) {
+    if (capacity < 1 || capacity > TF_CHANNEL_MAX_CAPACITY) return NULL;
+    
+    uint64_t size = 2;
+    while (size < (uint64_t)capacity) {
+        size <<= 1;
+    }
+    
+    TFChannel* channel = (TFChannel*)aligned_alloc(TF_CACHE_LINE, sizeof(TFChannel));
+    TFChannelCell* cells = (TFChannelCell*)malloc(size * sizeof(TFChannelCell));
+    if (channel == NULL || cells == NULL) {
+        tf_task_fail("Erro: Falha na alocação de memória");
+    }
+    
+    memset(channel, 0, sizeof(TFChannel));
+    for (uint64_t i = 0; i < size; i++) {
+        cells[i].sequence = i;
+    }
+    
+    channel->cells = cells;
+    channel->mask = size - 1;
+    channel->group = group;
+    pthread_mutex_init(&channel->lock, NULL);
+    
+    pthread_mutex_lock(&group->lock);
+    channel->next = group->channels;
+    group->channels = channel;
+    pthread_mutex_unlock(&group->lock);
+    
+    return channel;
+}
+
+static int tf_channel_push(TFChannel* channel, uint64_t value) {
+    uint64_t position = __atomic_load_n(&channel->send_position, __ATOMIC_RELAXED);
+    
+    for (;;) {
+        TFChannelCell* cell = &channel->cells[position & channel->mask];
+        uint64_t sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        int64_t difference = (int64_t)(sequence - position);
+        
+        if (difference == 0) {
+            if (__atomic_compare_exchange_n(&channel->send_position, &position, position + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                cell->value = value;
+                __atomic_store_n(&cell->sequence, position + 1, __ATOMIC_RELEASE);
+                return 1;
+            }
+        } else if (difference < 0) {
+            return 0;
+        } else {
+            position = __atomic_load_n(&channel->send_position, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static int tf_channel_pop(TFChannel* channel, uint64_t* value) {
+    uint64_t position = __atomic_load_n(&channel->receive_position, __ATOMIC_RELAXED);
+    
+    for (;;) {
+        TFChannelCell* cell = &channel->cells[position & channel->mask];
+        uint64_t sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        int64_t difference = (int64_t)(sequence - (position + 1));
+        
+        if (difference == 0) {
+            if (__atomic_compare_exchange_n(&channel->receive_position, &position, position + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                *value = cell->value;
+                __atomic_store_n(&cell->sequence, position + channel->mask + 1, __ATOMIC_RELEASE);
+                return 1;
+            }
+        } else if (difference < 0) {
+            return 0;
+        } else {
+            position = __atomic_load_n(&channel->receive_position, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+void tf_task_group_destroy(TFTaskGroup* group, void (*drop)(uint64_t value)) {
+    TFChannel* channel = group->channels;
+    
+    while (channel != NULL) {
+        TFChannel* next = channel->next;
+        uint64_t value;
+        
+        while (drop != NULL && tf_channel_pop(channel, &value)) {
+            drop(value);
+        }
+        
+        pthread_mutex_destroy(&channel->lock);
+        free(channel->cells);
+        free(channel);
+        channel = next;
+    }
+    
+    pthread_cond_destroy(&group->done_cond);
+    pthread_mutex_destroy(&group->lock);
+    free(group);
+}
+
+static void tf_channel_notify(TFChannel* channel, TFWaitList* list) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&list->waiting, __ATOMIC_RELAXED) == 0) return;
+    
+    pthread_mutex_lock(&channel->lock);
+    TFWaiter* waiter = tf_wait_list_pop(list);
+    if (waiter != NULL) {
+        tf_channel_wake(channel, waiter);
+    }
+    pthread_mutex_unlock(&channel->lock);
+}
+
+static TFChannelStatus tf_channel_block(TFChannel* channel, TFWaitList* list, TFTask* task) {
+    TFWaiter waiter;
+    waiter.task = task;
+    waiter.ready = 0;
+    
+    if (task != NULL) {
+        tf_wait_list_append(list, &waiter);
+        __atomic_add_fetch(&channel->group->parked, 1, __ATOMIC_SEQ_CST);
+        tf_task_park(task, &channel->lock);
+        return TF_CHANNEL_OK;
+    }
+    
+    TFChannelStatus status = TF_CHANNEL_OK;
+    pthread_cond_init(&waiter.cond, NULL);
+    tf_wait_list_append(list, &waiter);
+    __atomic_add_fetch(&channel->group->blocked, 1, __ATOMIC_SEQ_CST);
+    
+    while (!waiter.ready) {
+        struct timespec deadline;
+        tf_poll_deadline(&deadline);
+        
+        if (pthread_cond_timedwait(&waiter.cond, &channel->lock, &deadline) == ETIMEDOUT &&
+            !waiter.ready && tf_task_group_stalled(channel->group, tf_parallel_waiting_threads())) {
+            tf_wait_list_remove(list, &waiter);
+            __atomic_sub_fetch(&channel->group->blocked, 1, __ATOMIC_SEQ_CST);
+            status = TF_CHANNEL_DEADLOCK;
+            break;
+        }
+    }
+    
+    pthread_mutex_unlock(&channel->lock);
+    pthread_cond_destroy(&waiter.cond);
+    return status;
+}
+
+TFChannelStatus tf_channel_send(TFChannel* channel, uint64_t value) {
+    TFTask* task = tf_in_parallel ? NULL : tf_current_task;
+    
+    for (;;) {
+        if (__atomic_load_n(&channel->closed, __ATOMIC_ACQUIRE)) return TF_CHANNEL_CLOSED;
+        
+        if (tf_channel_push(channel, value)) {
+            tf_channel_notify(channel, &channel->receivers);
+            return TF_CHANNEL_OK;
+        }
+        
+        pthread_mutex_lock(&channel->lock);
+        __atomic_add_fetch(&channel->senders.waiting, 1, __ATOMIC_SEQ_CST);
+        
+        int closed = __atomic_load_n(&channel->closed, __ATOMIC_ACQUIRE);
+        int sent = !closed && tf_channel_push(channel, value);
+        TFChannelStatus status = TF_CHANNEL_OK;
+        
+        if (sent || closed) {
+            pthread_mutex_unlock(&channel->lock);
+        } else if (__atomic_load_n(&channel->group->cancelled, __ATOMIC_SEQ_CST)) {
+            pthread_mutex_unlock(&channel->lock);
+            status = TF_CHANNEL_CANCELLED;
+        } else {
+            status = tf_channel_block(channel, &channel->senders, task);
+        }
+        
+        __atomic_sub_fetch(&channel->senders.waiting, 1, __ATOMIC_SEQ_CST);
+        
+        if (sent) {
+            tf_channel_notify(channel, &channel->receivers);
+            return TF_CHANNEL_OK;
+        }
+        if (status != TF_CHANNEL_OK) return status;
+    }
+}
+
+TFChannelStatus tf_channel_receive(TFChannel* channel, uint64_t* value) {
+    TFTask* task = tf_in_parallel ? NULL : tf_current_task;
+    
+    for (;;) {
+        if (tf_channel_pop(channel, value)) {
+            tf_channel_notify(channel, &channel->senders);
+            return TF_CHANNEL_OK;
+        }
+        
+        if (__atomic_load_n(&channel->closed, __ATOMIC_ACQUIRE)) {
+            return tf_channel_pop(channel, value) ? TF_CHANNEL_OK : TF_CHANNEL_CLOSED;
+        }
+        
+        pthread_mutex_lock(&channel->lock);
+        __atomic_add_fetch(&channel->receivers.waiting, 1, __ATOMIC_SEQ_CST);
+        
+        int received = tf_channel_pop(channel, value);
+        int closed = __atomic_load_n(&channel->closed, __ATOMIC_ACQUIRE);
+        TFChannelStatus status = TF_CHANNEL_OK;
+        
+        if (received || closed) {
+            pthread_mutex_unlock(&channel->lock);
+        } else if (__atomic_load_n(&channel->group->cancelled, __ATOMIC_SEQ_CST)) {
+            pthread_mutex_unlock(&channel->lock);
+            status = TF_CHANNEL_CANCELLED;
+        } else {
+            status = tf_channel_block(channel, &channel->receivers, task);
+        }
+        
+        __atomic_sub_fetch(&channel->receivers.waiting, 1, __ATOMIC_SEQ_CST);
+        
+        if (received) {
+            tf_channel_notify(channel, &channel->senders);
+            return TF_CHANNEL_OK;
+        }
+        if (status != TF_CHANNEL_OK) return status;
+    }
+}
+
+TFChannelStatus tf_channel_close(TFChannel* channel) {
+    pthread_mutex_lock(&channel->lock);
+    
+    if (__atomic_load_n(&channel->closed, __ATOMIC_ACQUIRE)) {
+        pthread_mutex_unlock(&channel->lock);
+        return TF_CHANNEL_CLOSED;
+    }
+    
+    __atomic_store_n(&channel->closed, 1, __ATOMIC_SEQ_CST);
+    tf_channel_wake_all(channel);
+    pthread_mutex_unlock(&channel->lock);
+    return TF_CHANNEL_OK;
+}
+
+static struct {
+    pthread_once_t once;
+    TFTaskGroup* group;
+} tf_program_tasks = {
+    .once = PTHREAD_ONCE_INIT
+};
+
+static void tf_program_tasks_init(void) {
+    tf_program_tasks.group = tf_task_group_create();
+}
+
+static TFTaskGroup* tf_program_group(void) {
+    pthread_once(&tf_program_tasks.once, tf_program_tasks_init);
+    return tf_program_tasks.group;
+}
+
+static void tf_channel_check(TFChannelStatus status) {
+    switch (status) {
+        case TF_CHANNEL_CLOSED:
+            tf_task_fail("Erro: Envio para canal fechado");
+            break;
+        case TF_CHANNEL_DEADLOCK:
+            tf_task_fail("Erro: Deadlock: todas as tarefas estão bloqueadas em canais");
+            break;
+        case TF_CHANNEL_CANCELLED:
+            tf_task_fail("Erro: Tarefas canceladas");
+            break;
+        default:
+            break;
+    }
+}
+
+void tf_spawn(TFTaskBody body, void* env) {
+    tf_task_spawn(tf_program_group(), body, env);
+}
+
+void tf_spawn_wait(void) {
+    tf_channel_check(tf_task_group_wait(tf_program_group()));
+}
+
+TFChannel* tf_chan_new(int capacity) {
+    TFChannel* channel = tf_channel_create(tf_program_group(), capacity);
+    
+    if (channel == NULL) {
+        tf_output_flush();
+        fprintf(stderr, "Erro: Capacidade de canal inválida: %d\n", capacity);
+        exit(1);
+    }
+    return channel;
+}
+
+void tf_chan_send(TFChannel* channel, int64_t value) {
+    tf_channel_check(tf_channel_send(channel, (uint64_t)value));
+}
+
+int tf_chan_next(TFChannel* channel, int64_t* value) {
+    uint64_t received = 0;
+    TFChannelStatus status = tf_channel_receive(channel, &received);
+    
+    if (status == TF_CHANNEL_CLOSED) return 0;
+    
+    tf_channel_check(status);
+    *value = (int64_t)received;
+    return 1;
+}
+
+void tf_chan_close(TFChannel* channel) {
+    if (tf_channel_close(channel) != TF_CHANNEL_OK) {
+        tf_task_fail("Erro: Canal fechado mais de uma vez");
+    }
+}
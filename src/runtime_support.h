@@ -0,0 +1,94 @@
+#ifndef RUNTIME_SUPPORT_H
+#define RUNTIME_SUPPORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+typedef enum {
+    TF_REDUCE_ADD,
+    TF_REDUCE_MUL,
+    TF_REDUCE_AND,
+    TF_REDUCE_OR
+} TFReduceOp;
+
+typedef enum {
+    TF_READ_OK,
+    TF_READ_INVALID,
+    TF_READ_OUT_OF_RANGE
+} TFReadStatus;
+
+typedef struct {
+    const char* kind;
+    int line;
+    int64_t* counter;
+} TFInstrumentLoop;
+
+typedef enum {
+    TF_CHANNEL_OK,
+    TF_CHANNEL_CLOSED,
+    TF_CHANNEL_DEADLOCK,
+    TF_CHANNEL_CANCELLED
+} TFChannelStatus;
+
+#define TF_CHANNEL_DEFAULT_CAPACITY 64
+
+typedef struct TFReader TFReader;
+typedef struct TFTaskGroup TFTaskGroup;
+typedef struct TFChannel TFChannel;
+
+typedef void (*TFParallelBody)(void* env, int start, int end, int* partials);
+typedef void (*TFTaskBody)(void* env);
+typedef void* (*TFTaskLocalSwap)(void* value);
+
+void tf_instrument_register(const char* program, const TFInstrumentLoop* loops, int loop_count);
+void tf_instrument_dump(FILE* file);
+
+void tf_output_line(const char* data, size_t length);
+void tf_output_block(const char* data, size_t length);
+void tf_output_flush(void);
+void tf_log_i32(int value);
+void tf_log_str(const char* str);
+
+TFReader* tf_reader_open(FILE* file);
+void tf_reader_close(TFReader* reader);
+TFReadStatus tf_reader_read_i32(TFReader* reader, int* value);
+size_t tf_reader_read_line(TFReader* reader, const char** line);
+size_t tf_reader_offset(const TFReader* reader);
+int tf_reader_skip(TFReader* reader, size_t offset);
+void tf_reader_lock(TFReader* reader);
+void tf_reader_unlock(TFReader* reader);
+
+int tf_read_i32(void);
+char* tf_read_str(void);
+int tf_stdin_read_line(const char** line, size_t* length);
+
+double tf_monotonic_ms(void);
+void tf_budget_init(int64_t max_steps, int64_t max_ms, int64_t max_mem);
+void tf_budget_tick(void);
+
+int tf_parallel_worker_count(void);
+int tf_parallel_identity(int op);
+int tf_parallel_combine(int op, int left, int right);
+void tf_parallel_for(int start, int end, TFParallelBody body, void* env,
+                     const int* reduce_ops, int* reduce_values, int reduce_count);
+
+TFTaskGroup* tf_task_group_create(void);
+void tf_task_group_destroy(TFTaskGroup* group, void (*drop)(uint64_t value));
+void tf_task_spawn(TFTaskGroup* group, TFTaskBody body, void* env);
+void tf_task_set_local_swap(TFTaskLocalSwap swap);
+TFChannelStatus tf_task_group_wait(TFTaskGroup* group);
+void tf_task_group_cancel(TFTaskGroup* group);
+TFChannel* tf_channel_create(TFTaskGroup* group, int capacity);
+TFChannelStatus tf_channel_send(TFChannel* channel, uint64_t value);
+TFChannelStatus tf_channel_receive(TFChannel* channel, uint64_t* value);
+TFChannelStatus tf_channel_close(TFChannel* channel);
+
+void tf_spawn(TFTaskBody body, void* env);
+void tf_spawn_wait(void);
+TFChannel* tf_chan_new(int capacity);
+void tf_chan_send(TFChannel* channel, int64_t value);
+int tf_chan_next(TFChannel* channel, int64_t* value);
+void tf_chan_close(TFChannel* channel);
+
+#endif
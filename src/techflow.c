@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "llvm_generator.h"
+#include "interpreter.h"
+#include "program_image.h"
+#include "techflow.h"
+
+Node* parse_program(FILE* input, char* error, size_t error_size);
+void free_ast(Node* node);
+
+struct TFProgram {
+    Node* root;
+    ProgramImage image;
+};
+
+TFProgram* tf_compile_file(FILE* file, char* error, size_t error_size) {
+    Node* root = parse_program(file, error, error_size);
+    if (root == NULL) {
+        return NULL;
+    }
+    
+    TFProgram* program = (TFProgram*)malloc(sizeof(TFProgram));
+    if (program == NULL) {
+        snprintf(error, error_size, "Erro: Falha na alocação de memória");
+        free_ast(root);
+        return NULL;
+    }
+    
+    program->root = root;
+    program->image.data = NULL;
+    program->image.size = 0;
+    return program;
+}
+
+TFProgram* tf_compile(const char* source, char* error, size_t error_size) {
+    FILE* file = fmemopen((void*)source, strlen(source), "r");
+    if (file == NULL) {
+        snprintf(error, error_size, "Erro: não foi possível abrir o código fonte");
+        return NULL;
+    }
+    
+    TFProgram* program = tf_compile_file(file, error, error_size);
+    fclose(file);
+    return program;
+}
+
+TFProgram* tf_load(const char* path, char* error, size_t error_size) {
+    TFProgram* program = (TFProgram*)malloc(sizeof(TFProgram));
+    if (program == NULL) {
+        snprintf(error, error_size, "Erro: Falha na alocação de memória");
+        return NULL;
+    }
+    
+    program->root = load_program_image(path, &program->image, error, error_size);
+    if (program->root == NULL) {
+        free(program);
+        return NULL;
+    }
+    
+    return program;
+}
+
+TFResult tf_run(const TFProgram* program, const TFIO* io) {
+    TFResult result;
+    result.error[0] = '\0';
+    
+    FILE* input = io && io->input ? io->input : stdin;
+    FILE* output = io && io->output ? io->output : stdout;
+    
+    result.status = interpret_program(program->root, input, output, NULL, result.error, sizeof(result.error));
+    return result;
+}
+
+void tf_program_free(TFProgram* program) {
+    if (program == NULL) return;
+    
+    if (program->image.data != NULL) {
+        unload_program_image(&program->image);
+    } else {
+        free_ast(program->root);
+    }
+    free(program);
+}
@@ -0,0 +1,27 @@
+#ifndef TECHFLOW_H
+#define TECHFLOW_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+#define TF_ERROR_SIZE 256
+
+typedef struct TFProgram TFProgram;
+
+typedef struct {
+    FILE* input;
+    FILE* output;
+} TFIO;
+
+typedef struct {
+    int status;
+    char error[TF_ERROR_SIZE];
+} TFResult;
+
+TFProgram* tf_compile(const char* source, char* error, size_t error_size);
+TFProgram* tf_compile_file(FILE* file, char* error, size_t error_size);
+TFProgram* tf_load(const char* path, char* error, size_t error_size);
+TFResult tf_run(const TFProgram* program, const TFIO* io);
+void tf_program_free(TFProgram* program);
+
+#endif
@@ -0,0 +1,54 @@
+#include <stdio.h>
+#include "mem_stats.h"
+#include "techflow.h"
+
+static const char* failing_sources[] = {
+    "boot\n    byte x: i32 = 1 +;\nshutdown\n",
+    "boot\n    byte s: str = \"abc\" ++ ;\nshutdown\n",
+    "boot\n    log(1);\nshutdown\nlog(2);\n",
+    "boot\n    byte x: i32 = reader(bool);\nshutdown\n",
+    "boot\n    stream (x desde c) then\n        log(x);\n    end\nshutdown\n",
+    "boot\n    stream parallel (i from 0 ate 10) reduce(+: s) then\n        log(i);\n    end\nshutdown\n",
+    "boot\n    stream parallel (i from 0 to 10) reduce(+: s) then\n        log(i)\n        log(i);\n",
+    "boot\n    select (1) then\n        when 1 then log(1); end\n        otherwise then log(2); end\n        when then\n",
+    "boot\n    ping (1 < 2) then\n        byte y: str = \"texto longo\";\n    pong then\n        log(y);\n",
+    "boot\n    channel c: i32(4);\n    send(c, 1 2);\nshutdown\n",
+};
+
+static int compile_failures(void) {
+    int failures = 0;
+    
+    for (size_t i = 0; i < sizeof(failing_sources) / sizeof(failing_sources[0]); i++) {
+        char error[TF_ERROR_SIZE];
+        TFProgram* program = tf_compile(failing_sources[i], error, sizeof(error));
+        
+        if (program != NULL) {
+            fprintf(stderr, "Erro: programa %zu deveria falhar\n", i);
+            tf_program_free(program);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+int main(void) {
+    tf_mem_stats_enable();
+    
+    int failures = compile_failures();
+    long long live = tf_mem_live_bytes();
+    
+    for (int round = 0; round < 100; round++) {
+        failures += compile_failures();
+    }
+    
+    long long leaked = tf_mem_live_bytes() - live;
+    if (leaked != 0) {
+        fprintf(stderr, "Erro: %lld bytes perdidos em compilações com erro\n", leaked);
+        failures++;
+    }
+    
+    if (failures == 0) {
+        printf("test_parse_leak: ok\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
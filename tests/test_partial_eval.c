@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <string.h>
+#include "interpreter.h"
+
+Node* parse_program(FILE* input, char* error, size_t error_size);
+void free_ast(Node* node);
+
+static Node* parse_source(const char* source) {
+    char error[256];
+    FILE* input = fmemopen((void*)source, strlen(source), "r");
+    
+    if (input == NULL) return NULL;
+    
+    Node* root = parse_program(input, error, sizeof(error));
+    fclose(input);
+    
+    if (root == NULL) {
+        fprintf(stderr, "%s\n", error);
+    }
+    return root;
+}
+
+static int check_prefix(const char* name, const char* source, int expected_count, const char* expected_output) {
+    Node* root = parse_source(source);
+    
+    if (root == NULL) {
+        fprintf(stderr, "Erro: %s não foi analisado\n", name);
+        return 1;
+    }
+    
+    ExecutionLimits limits = { 100000, 0, 0 };
+    PrecomputedPrefix prefix;
+    int count = precompute_prefix(root->data.program.body, &limits, &prefix);
+    int failures = 0;
+    
+    if (count != expected_count) {
+        fprintf(stderr, "Erro: %s pré-calculou %d comandos, esperado %d\n", name, count, expected_count);
+        failures++;
+    } else if (prefix.output_size != strlen(expected_output) ||
+               memcmp(prefix.output, expected_output, prefix.output_size) != 0) {
+        fprintf(stderr, "Erro: %s gerou saída inesperada no prefixo\n", name);
+        failures++;
+    }
+    
+    char error[256];
+    FILE* output = fopen("/dev/null", "w");
+    FILE* input = fopen("/dev/null", "r");
+    if (interpret_program(root, input, output, NULL, error, sizeof(error)) == 0 ||
+        strstr(error, "Estouro") == NULL) {
+        fprintf(stderr, "Erro: %s deveria falhar com estouro no interpretador\n", name);
+        failures++;
+    }
+    fclose(output);
+    fclose(input);
+    
+    free_precomputed_prefix(&prefix);
+    free_ast(root);
+    return failures;
+}
+
+int main(void) {
+    int failures = 0;
+    
+    failures += check_prefix("divisão",
+                             "boot\n"
+                             "    byte a: i32 = 0 - 2147483647 - 1;\n"
+                             "    log(a);\n"
+                             "    byte b: i32 = a / (0 - 1);\n"
+                             "    log(b);\n"
+                             "shutdown\n",
+                             2, "-2147483648\n");
+    failures += check_prefix("módulo",
+                             "boot\n"
+                             "    byte a: i32 = 0 - 2147483647 - 1;\n"
+                             "    byte m: i32 = 0 - 1;\n"
+                             "    log(a % m);\n"
+                             "shutdown\n",
+                             2, "");
+    
+    if (failures == 0) {
+        printf("test_partial_eval: ok\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,173 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <unistd.h>
+#include "program_image.h"
+#include "techflow.h"
+
+Node* parse_program(FILE* input, char* error, size_t error_size);
+void free_ast(Node* node);
+
+static const char* source =
+    "boot\n"
+    "    byte total: i32 = 0;\n"
+    "    stream parallel (i from 0 to 10) reduce(+: total) then\n"
+    "        total = total + i;\n"
+    "    end\n"
+    "    select (total) then\n"
+    "        when 45 then log(\"quarenta e cinco\"); end\n"
+    "        otherwise then log(total); end\n"
+    "    end\n"
+    "    channel c: i32(2);\n"
+    "    spawn then\n"
+    "        send(c, total);\n"
+    "        close(c);\n"
+    "    end\n"
+    "    stream (v from c) then\n"
+    "        log(v);\n"
+    "    end\n"
+    "shutdown\n";
+
+typedef struct {
+    unsigned char* data;
+    size_t size;
+} ImageBytes;
+
+static int write_bytes(const char* path, const ImageBytes* image) {
+    FILE* file = fopen(path, "wb");
+    int ok = file != NULL && fwrite(image->data, 1, image->size, file) == image->size;
+    
+    if (file != NULL && fclose(file) != 0) ok = 0;
+    return ok;
+}
+
+static int read_bytes(const char* path, ImageBytes* image) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) return 0;
+    
+    fseek(file, 0, SEEK_END);
+    image->size = (size_t)ftell(file);
+    rewind(file);
+    image->data = (unsigned char*)malloc(image->size);
+    int ok = image->data != NULL && fread(image->data, 1, image->size, file) == image->size;
+    fclose(file);
+    return ok;
+}
+
+static uint64_t read_word(const ImageBytes* image, uint64_t offset) {
+    uint64_t value;
+    memcpy(&value, image->data + offset, sizeof(value));
+    return value;
+}
+
+static void write_int(ImageBytes* image, uint64_t offset, int value) {
+    memcpy(image->data + offset, &value, sizeof(value));
+}
+
+static void write_word(ImageBytes* image, uint64_t offset, uint64_t value) {
+    memcpy(image->data + offset, &value, sizeof(value));
+}
+
+static int expect_rejected(const char* name, const char* path, const ImageBytes* image) {
+    char error[TF_ERROR_SIZE];
+    
+    if (!write_bytes(path, image)) {
+        fprintf(stderr, "Erro: não foi possível gravar a imagem %s\n", name);
+        return 1;
+    }
+    
+    TFProgram* program = tf_load(path, error, sizeof(error));
+    if (program != NULL) {
+        fprintf(stderr, "Erro: imagem %s corrompida foi aceita\n", name);
+        tf_program_free(program);
+        return 1;
+    }
+    if (strstr(error, "corrompido") == NULL) {
+        fprintf(stderr, "Erro: imagem %s rejeitada com a mensagem '%s'\n", name, error);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void) {
+    char path[] = "/tmp/techflow-image-XXXXXX";
+    char error[TF_ERROR_SIZE];
+    int fd = mkstemp(path);
+    
+    if (fd < 0) {
+        fprintf(stderr, "Erro: não foi possível criar arquivo temporário\n");
+        return 1;
+    }
+    close(fd);
+    
+    FILE* input = fmemopen((void*)source, strlen(source), "r");
+    Node* root = parse_program(input, error, sizeof(error));
+    fclose(input);
+    
+    int failures = 0;
+    if (root == NULL || write_program_image(root, path, error, sizeof(error)) != 0) {
+        fprintf(stderr, "Erro: não foi possível gerar a imagem: %s\n", error);
+        unlink(path);
+        return 1;
+    }
+    free_ast(root);
+    
+    TFProgram* program = tf_load(path, error, sizeof(error));
+    if (program == NULL) {
+        fprintf(stderr, "Erro: imagem válida rejeitada: %s\n", error);
+        failures++;
+    } else {
+        FILE* output = fopen("/dev/null", "w");
+        TFIO io = { NULL, output };
+        if (tf_run(program, &io).status != 0) {
+            fprintf(stderr, "Erro: imagem válida não executou\n");
+            failures++;
+        }
+        fclose(output);
+        tf_program_free(program);
+    }
+    
+    ImageBytes original;
+    if (!read_bytes(path, &original)) {
+        fprintf(stderr, "Erro: não foi possível ler a imagem\n");
+        unlink(path);
+        return 1;
+    }
+    
+    ProgramImageHeader header;
+    memcpy(&header, original.data, sizeof(header));
+    uint64_t root_offset = header.root_offset;
+    uint64_t body_field = root_offset + offsetof(Node, data.program.body);
+    uint64_t body_offset = read_word(&original, body_field);
+    ImageBytes image = { (unsigned char*)malloc(original.size), original.size };
+    
+    memcpy(image.data, original.data, original.size);
+    write_int(&image, root_offset + offsetof(Node, type), 999);
+    failures += expect_rejected("com tipo de nó inválido", path, &image);
+    
+    memcpy(image.data, original.data, original.size);
+    write_word(&image, body_field, root_offset);
+    failures += expect_rejected("com ciclo", path, &image);
+    
+    memcpy(image.data, original.data, original.size);
+    write_int(&image, body_offset + offsetof(Node, data.block.stmt_count), 1 << 28);
+    failures += expect_rejected("com contagem de filhos grande demais", path, &image);
+    
+    memcpy(image.data, original.data, original.size);
+    write_int(&image, body_offset + offsetof(Node, data.block.stmt_count), -1);
+    failures += expect_rejected("com contagem de filhos negativa", path, &image);
+    
+    memcpy(image.data, original.data, original.size);
+    write_word(&image, body_offset + offsetof(Node, next), body_offset);
+    failures += expect_rejected("com ponteiro fora da relocação", path, &image);
+    
+    free(image.data);
+    free(original.data);
+    unlink(path);
+    
+    if (failures == 0) {
+        printf("test_program_image: ok\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "mem_stats.h"
+#include "runtime_support.h"
+
+#define TASKS_PER_ACCOUNT 64
+
+typedef struct {
+    TFMemAccount* account;
+    TFChannel* channel;
+    size_t size;
+    void* before;
+    void* after;
+} AccountTask;
+
+static void* swap_account(void* account) {
+    return tf_mem_account_enter((TFMemAccount*)account);
+}
+
+static void run_account_task(void* env) {
+    AccountTask* task = (AccountTask*)env;
+    TFMemAccount* previous = tf_mem_account_enter(task->account);
+    uint64_t value;
+    
+    task->before = tf_malloc(task->size);
+    tf_channel_receive(task->channel, &value);
+    task->after = tf_malloc(task->size);
+    tf_mem_account_leave(previous);
+}
+
+static int check_live(const char* name, TFMemAccount* account, long long expected) {
+    long long live = tf_mem_account_live_bytes(account);
+    
+    if (live != expected) {
+        fprintf(stderr, "Erro: conta %s com %lld bytes vivos, esperado %lld\n", name, live, expected);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void) {
+    setenv("TECHFLOW_THREADS", "4", 0);
+    tf_task_set_local_swap(swap_account);
+    
+    TFMemAccount* outer = tf_mem_account_create();
+    TFMemAccount* first = tf_mem_account_create();
+    TFMemAccount* second = tf_mem_account_create();
+    TFMemAccount* previous = tf_mem_account_enter(outer);
+    
+    TFTaskGroup* group = tf_task_group_create();
+    TFChannel* channel = tf_channel_create(group, TASKS_PER_ACCOUNT * 2);
+    AccountTask tasks[TASKS_PER_ACCOUNT * 2];
+    
+    for (int i = 0; i < TASKS_PER_ACCOUNT * 2; i++) {
+        tasks[i].account = i % 2 == 0 ? first : second;
+        tasks[i].channel = channel;
+        tasks[i].size = i % 2 == 0 ? 100 : 1000;
+        tf_task_spawn(group, run_account_task, &tasks[i]);
+    }
+    for (int i = 0; i < TASKS_PER_ACCOUNT * 2; i++) {
+        tf_channel_send(channel, (uint64_t)i);
+    }
+    
+    int failures = 0;
+    if (tf_task_group_wait(group) != TF_CHANNEL_OK) {
+        fprintf(stderr, "Erro: tarefas não terminaram\n");
+        failures++;
+    }
+    
+    failures += check_live("externa", outer, 0);
+    failures += check_live("primeira", first, TASKS_PER_ACCOUNT * 200);
+    failures += check_live("segunda", second, TASKS_PER_ACCOUNT * 2000);
+    
+    tf_mem_account_leave(previous);
+    for (int i = 0; i < TASKS_PER_ACCOUNT * 2; i++) {
+        tf_free(tasks[i].before);
+        tf_free(tasks[i].after);
+    }
+    failures += check_live("primeira", first, 0);
+    failures += check_live("segunda", second, 0);
+    
+    tf_task_group_destroy(group, NULL);
+    tf_mem_account_release(outer);
+    tf_mem_account_release(first);
+    tf_mem_account_release(second);
+    
+    if (failures == 0) {
+        printf("test_task_account: ok\n");
+    }
+    return failures == 0 ? 0 : 1;
+}